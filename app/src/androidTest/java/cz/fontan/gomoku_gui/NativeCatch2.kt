@@ -24,6 +24,11 @@ class NativeCatch2 {
         assert(0 == NativeInterface.runCatch2Test("Basic*"))
     }
 
+    @Test
+    fun board() {
+        assert(0 == NativeInterface.runCatch2Test("Board*"))
+    }
+
     @Test
     fun config() {
         assert(0 == NativeInterface.runCatch2Test("Config*"))
@@ -38,4 +43,44 @@ class NativeCatch2 {
     fun lockedQueue() {
         assert(0 == NativeInterface.runCatch2Test("LockedQueue*"))
     }
-}
\ No newline at end of file
+
+    @Test
+    fun log() {
+        assert(0 == NativeInterface.runCatch2Test("Log*"))
+    }
+
+    @Test
+    fun openingBook() {
+        assert(0 == NativeInterface.runCatch2Test("OpeningBook*"))
+    }
+
+    @Test
+    fun search() {
+        assert(0 == NativeInterface.runCatch2Test("Search*"))
+    }
+
+    @Test
+    fun spscQueue() {
+        assert(0 == NativeInterface.runCatch2Test("SpscQueue*"))
+    }
+
+    @Test
+    fun timeManager() {
+        assert(0 == NativeInterface.runCatch2Test("TimeManager*"))
+    }
+
+    @Test
+    fun transpositionTable() {
+        assert(0 == NativeInterface.runCatch2Test("TranspositionTable*"))
+    }
+
+    @Test
+    fun vcf() {
+        assert(0 == NativeInterface.runCatch2Test("Vcf*"))
+    }
+
+    @Test
+    fun vct() {
+        assert(0 == NativeInterface.runCatch2Test("Vct*"))
+    }
+}
@@ -4,6 +4,7 @@
  */
 
 #include "board.h"
+#include "zobrist.h"
 
 #include <cstring>
 
@@ -11,9 +12,13 @@ Board::Board( const coord_t dim ) : Board( dim, dim ) {}
 
 Board::Board( const coord_t dimX, const coord_t dimY ) :
         m_gamePly( 0U ),
+        m_key( 0U ),
         m_DimX( dimX ),
         m_DimY( dimY ),
-        sideToMove( true ) {
+        sideToMove( true ),
+        m_winPly( 0U ),
+        m_rule( eRuleFreestyle ),
+        m_forbidBlack( eMove_t::eXX ) {
     assert( m_DimX <= kPlaySize );
     assert( m_DimY <= kPlaySize );
     assert( m_DimX >= 5 );
@@ -21,22 +26,6 @@ Board::Board( const coord_t dimX, const coord_t dimY ) :
     Reset();
 }
 
-Board::Board( const Board& other ) : Board( other.GetDimX(), other.GetDimY()) {
-    for( coord_t x = 0; x < m_DimX; x++ ) {
-        for( coord_t y = 0; y < m_DimY; y++ ) {
-            if( other.m_desk[x * kBoardSize + y] != eMove_t::eEmpty ) {
-                if( other.m_desk[x * kBoardSize + y] == eMove_t::eXX ) {
-                    MakeMove( createMove<eMove_t::eXX>( x, y ));
-                } else {
-                    MakeMove( createMove<eMove_t::eOO>( x, y ));
-                }
-            }
-        }
-    }
-
-    sideToMove = other.SideToMove();
-}
-
 void Board::MakeMove( const Move m ) {
     assert( !IsEmpty( m ));
     assert( CanMakeMove( m ));
@@ -48,14 +37,34 @@ void Board::MakeMove( const Move m ) {
         PutMove<eMove_t::eOO>( m );
         SetSideToMove( true );
     }
+    assert( IsKeyConsistent());
 }
 
 template<eMove_t player>
 void Board::PutMove( const Move m ) {
     static_assert( player == eMove_t::eXX || player == eMove_t::eOO, "Bad player" );
 
+    // the five cells of the player are known before the stone is put
+    const auto five = (( m_threats[PlayerIndex( player )][eThreatFive][GetX( m )] >> GetY( m )) & 1U ) != 0U &&
+                      ( IsOverlineWin( player ) || IsFive( player, GetX( m ), GetY( m )));
+    const auto bit  = uint64_t{ 1U } << ( m_gamePly % 64U );
+    auto&      word = m_fives[m_gamePly / 64U];
+    word = five ? word | bit : word & ~bit;
+
     m_playedMoves[m_gamePly++] = GetPlainMove( m );
+    ++m_stones[PlayerIndex( player )];
+    if( five && m_winPly == 0U ) {
+        m_winPly = m_gamePly;
+    }
+    m_key ^= Zobrist::PieceKey( player, GetCoords( m ));
+    UpdateSymmetryKeys( player, GetX( m ), GetY( m ));
+    UpdateCodes<true>( player, GetX( m ), GetY( m ));
     SetDesk( m, player );
+    UpdateCandidates<true>( GetX( m ), GetY( m ));
+    SyncThreats( GetCoords( m ));
+    if( m_rule == eRuleRenju ) {
+        InvalidateForbidden( GetX( m ), GetY( m ));
+    }
 }
 
 void Board::UndoMove( const Move m ) {
@@ -65,18 +74,233 @@ void Board::UndoMove( const Move m ) {
     assert( m_playedMoves[m_gamePly - 1] == GetPlainMove( m ));
 
     SwitchSideToMove();
-    m_desk[GetCoords( m )] = eMove_t::eEmpty;
+    const auto piece = GetCell( GetCoords( m ));
+    m_key ^= Zobrist::PieceKey( piece, GetCoords( m ));
+    UpdateSymmetryKeys( piece, GetX( m ), GetY( m ));
+    UpdateCodes<false>( piece, GetX( m ), GetY( m ));
+    SetCell( GetCoords( m ), eMove_t::eEmpty );
+    UpdateCandidates<false>( GetX( m ), GetY( m ));
+    SyncThreats( GetCoords( m ));
+    if( m_rule == eRuleRenju ) {
+        InvalidateForbidden( GetX( m ), GetY( m ));
+    }
+    if( m_winPly == m_gamePly ) {
+        m_winPly = 0U;
+    }
+    --m_stones[PlayerIndex( piece )];
     --m_gamePly;
 
     assert( CanMakeMove( m ));
+    assert( IsKeyConsistent());
+}
+
+void Board::SwitchSideToMove() {
+    sideToMove = !sideToMove;
+    m_key ^= Zobrist::SideKey();
+}
+
+uint64_t Board::GetKeyAfter( const Move m ) const {
+    assert( IsTypeXX( m ) || IsTypeOO( m ));
+    auto key = m_key ^ Zobrist::PieceKey( GetType( m ), GetCoords( m ));
+    if( IsTypeXX( m ) == sideToMove ) {
+        key ^= Zobrist::SideKey();
+    }
+    return key;
+}
+
+uint64_t Board::ComputeKey() const {
+    auto key = sideToMove ? uint64_t{ 0U } : Zobrist::SideKey();
+    for( coord_t x = 0; x < m_DimX; x++ ) {
+        for( coord_t y = 0; y < m_DimY; y++ ) {
+            const auto coords = x * kBoardSize + y;
+            const auto piece  = GetCell( coords );
+            if( piece == eMove_t::eXX || piece == eMove_t::eOO ) {
+                key ^= Zobrist::PieceKey( piece, coords );
+            }
+        }
+    }
+    return key;
+}
+
+void Board::UpdateSymmetryKeys( const eMove_t player, const coord_t x, const coord_t y ) {
+    auto* const keys  = m_symKeys[PlayerIndex( player )];
+    const auto  count = GetSymmetryCount();
+    for( uint32_t s = 0U; s < count; ++s ) {
+        auto tx = x;
+        auto ty = y;
+        Transform( s, tx, ty );
+        keys[s] ^= Zobrist::CellKey( tx * kBoardSize + ty );
+    }
+}
+
+uint64_t Board::GetCanonicalKey( const eMove_t first, uint32_t& symmetry ) const {
+    symmetry  = 0U;
+    auto best = GetSymmetryKey( 0U, first );
+    for( uint32_t s = 1U; s < GetSymmetryCount(); ++s ) {
+        const auto key = GetSymmetryKey( s, first );
+        if( key < best ) {
+            best     = key;
+            symmetry = s;
+        }
+    }
+    return best;
+}
+
+uint64_t Board::ComputeSymmetryKey( const uint32_t symmetry, const eMove_t first ) const {
+    uint64_t cells[2] = {};
+    for( coord_t x = 0; x < m_DimX; x++ ) {
+        for( coord_t y = 0; y < m_DimY; y++ ) {
+            const auto piece = GetDesk( x, y );
+            if( piece == eMove_t::eXX || piece == eMove_t::eOO ) {
+                auto tx = x;
+                auto ty = y;
+                Transform( symmetry, tx, ty );
+                cells[piece == first ? 0 : 1] ^= Zobrist::CellKey( tx * kBoardSize + ty );
+            }
+        }
+    }
+    return cells[0] ^ Zobrist::SecondColour( cells[1] );
 }
 
 void Board::Reset() {
-    m_gamePly  = 0U;
-    sideToMove = true;
+    m_gamePly   = 0U;
+    m_winPly    = 0U;
+    m_stones[0] = 0U;
+    m_stones[1] = 0U;
+    m_key       = 0U;
+    sideToMove  = true;
+    std::memset( m_symKeys, 0, sizeof( m_symKeys ));
 
-    for( auto& x : m_desk ) {
-        x = eMove_t::eEmpty;
+    for( coord_t x = 0; x < kMaxBoard; x++ ) {
+        for( coord_t y = 0; y < kBoardSize; y++ ) {
+            SetCell( x * kBoardSize + y, x < m_DimX && y < m_DimY ? eMove_t::eEmpty : eMove_t::eBlock );
+        }
+    }
+
+    // no stones, no candidates and threats
+    std::memset( m_near, 0, sizeof( m_near ));
+    std::memset( m_candidates, 0, sizeof( m_candidates ));
+    std::memset( m_threats, 0, sizeof( m_threats ));
+    std::memset( m_threatDirs, 0, sizeof( m_threatDirs ));
+    std::memset( m_forbid, eForbidUnknown, sizeof( m_forbid ));
+    std::memset( m_fives, 0, sizeof( m_fives ));
+
+    // cells outside of the playing area block both players
+    std::memset( m_codes, 0, sizeof( m_codes ));
+    for( coord_t x = 0; x < m_DimX; x++ ) {
+        for( coord_t y = 0; y < m_DimY; y++ ) {
+            for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+                for( auto k = -static_cast<int>( kLineHalf ); k <= static_cast<int>( kLineHalf ); ++k ) {
+                    const auto nx = static_cast<int>( x ) + k * kDirX[dir];
+                    const auto ny = static_cast<int>( y ) + k * kDirY[dir];
+                    if( k != 0 && GetDeskOrWall( nx, ny ) == eMove_t::eBlock ) {
+                        const auto blocked = eLineBlocked * kCodePow3[Pattern::CodeDigit( k )];
+                        for( auto& codes : m_codes ) {
+                            auto& code = codes[x * kBoardSize + y][dir];
+                            code = static_cast<uint16_t>( code + blocked );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<bool add>
+void Board::UpdateCodes( const eMove_t player, const coord_t x, const coord_t y ) {
+    auto& own = m_codes[PlayerIndex( player )];
+    auto& opp = m_codes[1U - PlayerIndex( player )];
+
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        for( auto k = -static_cast<int>( kLineHalf ); k <= static_cast<int>( kLineHalf ); ++k ) {
+            const auto nx = static_cast<int>( x ) + k * kDirX[dir];
+            const auto ny = static_cast<int>( y ) + k * kDirY[dir];
+            if( k == 0 || GetDeskOrWall( nx, ny ) == eMove_t::eBlock ) {
+                continue;
+            }
+            // the stone is at offset -k seen from the neighbour
+            const auto pow3   = kCodePow3[Pattern::CodeDigit( -k )];
+            const auto cell   = static_cast<uint32_t>( nx ) * kBoardSize + static_cast<uint32_t>( ny );
+            auto&      ownVal = own[cell][dir];
+            auto&      oppVal = opp[cell][dir];
+            const auto ownOld = Pattern::FromCode( ownVal );
+            const auto oppOld = Pattern::FromCode( oppVal );
+            if constexpr( add ) {
+                ownVal = static_cast<uint16_t>( ownVal + eLineOwn * pow3 );
+                oppVal = static_cast<uint16_t>( oppVal + eLineBlocked * pow3 );
+            } else {
+                ownVal = static_cast<uint16_t>( ownVal - eLineOwn * pow3 );
+                oppVal = static_cast<uint16_t>( oppVal - eLineBlocked * pow3 );
+            }
+            UpdateThreats( PlayerIndex( player ), cell, ownOld, Pattern::FromCode( ownVal ));
+            UpdateThreats( 1U - PlayerIndex( player ), cell, oppOld, Pattern::FromCode( oppVal ));
+        }
+    }
+}
+
+template<bool add>
+void Board::UpdateCandidates( const coord_t x, const coord_t y ) {
+    for( auto dx = -kNearDist; dx <= kNearDist; ++dx ) {
+        for( auto dy = -kNearDist; dy <= kNearDist; ++dy ) {
+            const auto nx = static_cast<int>( x ) + dx;
+            const auto ny = static_cast<int>( y ) + dy;
+            const auto piece = GetDeskOrWall( nx, ny );
+            if( piece == eMove_t::eBlock ) {
+                continue;
+            }
+            const auto cell = static_cast<uint32_t>( nx ) * kBoardSize + static_cast<uint32_t>( ny );
+            const auto bit  = 1U << static_cast<uint32_t>( ny );
+            auto&      mask = m_candidates[static_cast<uint32_t>( nx )];
+            if constexpr( add ) {
+                ++m_near[cell];
+                if( piece == eMove_t::eEmpty ) {
+                    mask |= bit;
+                }
+            } else {
+                --m_near[cell];
+                if( m_near[cell] == 0U ) {
+                    mask &= ~bit;
+                }
+            }
+        }
+    }
+
+    // the cell of the stone itself
+    const auto bit = 1U << y;
+    if( add || m_near[x * kBoardSize + y] == 0U ) {
+        m_candidates[x] &= ~bit;
+    } else {
+        m_candidates[x] |= bit;
+    }
+}
+
+void Board::UpdateThreats( const uint32_t player, const coords_t cell, const ePattern before,
+                           const ePattern after ) {
+    // weak patterns are the common case
+    if( before == after || std::max( before, after ) < kThreatPattern[0] ) {
+        return;
+    }
+    const auto empty = GetCell( cell ) == eMove_t::eEmpty;
+    for( uint32_t level = 0U; level < eThreatCount; ++level ) {
+        auto& count = m_threatDirs[player][level][cell];
+        if( before >= kThreatPattern[level] ) {
+            --count;
+        }
+        if( after >= kThreatPattern[level] ) {
+            ++count;
+        }
+        if( empty ) {
+            SetThreatBit( player, level, cell, count > 0U );
+        }
+    }
+}
+
+void Board::SyncThreats( const coords_t cell ) {
+    const auto empty = GetCell( cell ) == eMove_t::eEmpty;
+    for( uint32_t player = 0U; player < 2U; ++player ) {
+        for( uint32_t level = 0U; level < eThreatCount; ++level ) {
+            SetThreatBit( player, level, cell, empty && m_threatDirs[player][level][cell] > 0U );
+        }
     }
 }
 
@@ -84,3 +308,140 @@ bool Board::IsFull() const {
     assert( GetGamePly() <= static_cast<size_t>( m_DimX ) * m_DimY );
     return GetGamePly() == static_cast<size_t>( m_DimX ) * m_DimY;
 }
+
+void Board::SetRule( const eRule rule ) {
+    m_rule = rule;
+    std::memset( m_forbid, eForbidUnknown, sizeof( m_forbid ));
+}
+
+bool Board::IsFive( const eMove_t player, const coord_t x, const coord_t y, const uint32_t dir ) const {
+    if( GetPattern( player, x, y, dir ) != ePatFive ) {
+        return false;
+    }
+    if( IsOverlineWin( player )) {
+        return true;
+    }
+    Renju::Window w;
+    GetWindow( player, x, y, dir, w );
+    return Renju::CentreRun( w ) == 5U;
+}
+
+bool Board::IsFive( const eMove_t player, const coord_t x, const coord_t y ) const {
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        if( IsFive( player, x, y, dir )) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Board::GetWindow( const eMove_t player, const coord_t x, const coord_t y, const uint32_t dir,
+                       Renju::Window& w ) const {
+    for( uint32_t i = 0U; i < Renju::kSize; ++i ) {
+        const auto k    = static_cast<int>( i ) - static_cast<int>( Renju::kHalf );
+        const auto cell = GetDeskOrWall( static_cast<int>( x ) + k * kDirX[dir],
+                                         static_cast<int>( y ) + k * kDirY[dir] );
+        w[i] = k == 0 || cell == player ? eLineOwn : cell == eMove_t::eEmpty ? eLineEmpty : eLineBlocked;
+    }
+}
+
+bool Board::IsForbidden( const eMove_t player, const coord_t x, const coord_t y ) {
+    if( m_rule != eRuleRenju || player != GetBlack() || GetDesk( x, y ) != eMove_t::eEmpty ) {
+        return false;
+    }
+    // renju threes and fours are open threes and fours of the patterns, most cells have none
+    const auto  cell = x * kBoardSize + y;
+    const auto& dirs = m_threatDirs[PlayerIndex( player )];
+    if( dirs[eThreatThree][cell] < 2U && dirs[eThreatFour][cell] == 0U ) {
+        return false;
+    }
+    if( m_forbidBlack != player ) {
+        // the side to move was changed without a move, the colours are swapped
+        m_forbidBlack = player;
+        std::memset( m_forbid, eForbidUnknown, sizeof( m_forbid ));
+    }
+
+    auto& cached = m_forbid[cell];
+    if( cached == eForbidUnknown ) {
+        cached = ClassifyForbidden( x, y );
+    }
+    return cached == eForbidYes || ( cached == eForbidThrees && CountRealThrees( x, y, 0U ) >= 2U );
+}
+
+Board::eForbid Board::ClassifyForbidden( const coord_t x, const coord_t y ) const {
+    Renju::Window w[kDirCount];
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        GetWindow( m_forbidBlack, x, y, dir, w[dir] );
+        if( Renju::CentreRun( w[dir] ) == 5U ) {
+            // five wins over any forbidden shape
+            return eForbidNo;
+        }
+    }
+
+    auto fours  = 0U;
+    auto threes = 0U;
+    for( const auto& line : w ) {
+        if( Renju::CentreRun( line ) > 5U ) {
+            return eForbidYes;
+        }
+        auto       straight = false;
+        const auto n        = Renju::CountFours( line, straight );
+        uint32_t   cells[Renju::kSize];
+        fours += n;
+        threes += n == 0U && Renju::ThreeExtensions( line, cells ) > 0U ? 1U : 0U;
+    }
+    if( fours >= 2U ) {
+        return eForbidYes;
+    }
+    return threes >= 2U ? eForbidThrees : eForbidNo;
+}
+
+bool Board::IsForbiddenAt( const coord_t x, const coord_t y, const uint32_t depth ) {
+    const auto shape = ClassifyForbidden( x, y );
+    if( shape != eForbidThrees ) {
+        return shape == eForbidYes;
+    }
+    return depth >= kForbidDepth || CountRealThrees( x, y, depth ) >= 2U;
+}
+
+uint32_t Board::CountRealThrees( const coord_t x, const coord_t y, const uint32_t depth ) {
+    const auto cell = x * kBoardSize + y;
+    SetCell( cell, m_forbidBlack );
+
+    auto threes = 0U;
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        Renju::Window w;
+        GetWindow( m_forbidBlack, x, y, dir, w );
+        auto     straight = false;
+        uint32_t cells[Renju::kSize];
+        if( Renju::CountFours( w, straight ) > 0U ) {
+            continue;
+        }
+        // the three is real if one of its open fours can be played
+        const auto count = Renju::ThreeExtensions( w, cells );
+        for( auto i = 0U; i < count; ++i ) {
+            const auto k  = static_cast<int>( cells[i] ) - static_cast<int>( Renju::kHalf );
+            const auto ex = static_cast<coord_t>( static_cast<int>( x ) + k * kDirX[dir] );
+            const auto ey = static_cast<coord_t>( static_cast<int>( y ) + k * kDirY[dir] );
+            if( !IsForbiddenAt( ex, ey, depth + 1U )) {
+                ++threes;
+                break;
+            }
+        }
+    }
+
+    SetCell( cell, eMove_t::eEmpty );
+    return threes;
+}
+
+void Board::InvalidateForbidden( const coord_t x, const coord_t y ) {
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        for( auto k = -static_cast<int>( Renju::kHalf ); k <= static_cast<int>( Renju::kHalf ); ++k ) {
+            const auto nx = static_cast<int>( x ) + k * kDirX[dir];
+            const auto ny = static_cast<int>( y ) + k * kDirY[dir];
+            if( GetDeskOrWall( nx, ny ) != eMove_t::eBlock ) {
+                m_forbid[static_cast<uint32_t>( nx ) * kBoardSize + static_cast<uint32_t>( ny )] = eForbidUnknown;
+            }
+        }
+    }
+}
@@ -7,9 +7,28 @@
  */
 
 #include "gameTypes.h"
+#include "pattern.h"
+#include "renju.h"
+#include "zobrist.h"
 
 #include <cassert>
 #include <cstring>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @enum eThreat
+ * @brief Threat levels of empty cells, every level includes the stronger ones
+ */
+enum eThreat : uint8_t {
+    eThreatThree, /**< best pattern of the cell is an open three or more */
+    eThreatFour,  /**< best pattern of the cell is a four or more */
+    eThreatFive,  /**< the cell makes five */
+    eThreatCount
+};
+
+/** Weakest pattern of the threat levels */
+constexpr ePattern kThreatPattern[eThreatCount] = { ePatFlex3, ePatBlock4, ePatFive };
 
 /**
  * @class Board
@@ -17,6 +36,7 @@
  */
 class Board {
 public:
+    static constexpr uint32_t kSymmetries = 8U; /**< rotations and reflections of a square board */
 
     /**
      * @brief Constructor
@@ -31,16 +51,12 @@ public:
      */
     explicit Board( const coord_t dimX, const coord_t dimY );
 
-    /**
-     * @brief Copy Constructor
-     * @param other board copy from
-     */
-    Board( const Board& other );
-    ~Board() = default; /**< destructor */
-    Board() = delete;                 /**< hidden default constructor */
-    Board( Board&& ) = delete;                 /**< hidden move copy constructor */
-    Board& operator=( const Board& ) = delete; /**< hidden assignment operator @return this */
-    Board& operator=( Board&& ) = delete;      /**< hidden move assignment operator @return this */
+    Board( const Board& ) = default;            /**< copy constructor, flat copy including the move history */
+    ~Board() = default;                         /**< destructor */
+    Board() = delete;                           /**< hidden default constructor */
+    Board( Board&& ) = default;                 /**< move copy constructor, same as the copy */
+    Board& operator=( const Board& ) = default; /**< assignment operator, flat copy @return this */
+    Board& operator=( Board&& ) = default;      /**< move assignment operator, same as the copy @return this */
 
     /**
      * @brief Prepare board for game
@@ -100,12 +116,113 @@ public:
      */
     [[nodiscard]] bool IsFull() const;
 
+    /**
+     * @brief Check if the last played move completed a winning five under the game rule
+     * @return five status, false for an empty board, tracked by the moves
+     */
+    [[nodiscard]] bool IsLastMoveFive() const {
+        return m_gamePly > 0U && (( m_fives[( m_gamePly - 1U ) / 64U] >> (( m_gamePly - 1U ) % 64U )) & 1U ) != 0U;
+    }
+
+    /**
+     * @brief Player of the first winning five, eEmpty while nobody won
+     */
+    [[nodiscard]] eMove_t GetWinner() const {
+        return m_winPly > 0U ? GetType( m_playedMoves[m_winPly - 1U] ) : eMove_t::eEmpty;
+    }
+
+    /**@{
+     * @brief Game rule, kept by Reset()
+     */
+    void SetRule( eRule rule );
+
+    [[nodiscard]] eRule GetRule() const { return m_rule; }
+    /**@}*/
+
+    /**
+     * @brief Stones of the first player, more stones or the side to move if both have the same count
+     *
+     * Positions of BOARD and YXBOARD do not say who started, the move order is not needed.
+     */
+    [[nodiscard]] eMove_t GetBlack() const {
+        if( m_stones[0] != m_stones[1] ) {
+            return m_stones[0] > m_stones[1] ? eMove_t::eXX : eMove_t::eOO;
+        }
+        return sideToMove ? eMove_t::eXX : eMove_t::eOO;
+    }
+
+    /**
+     * @brief Test if six or more stones of the player win
+     */
+    [[nodiscard]] bool IsOverlineWin( const eMove_t player ) const {
+        return m_rule == eRuleFreestyle || ( m_rule == eRuleRenju && player != GetBlack());
+    }
+
+    /**@{
+     * @brief Test if the player makes a winning five on the empty cell, in one or any direction
+     */
+    [[nodiscard]] bool IsFive( eMove_t player, coord_t x, coord_t y, uint32_t dir ) const;
+
+    [[nodiscard]] bool IsFive( eMove_t player, coord_t x, coord_t y ) const;
+    /**@}*/
+
+    /**
+     * @brief Test if the move is forbidden, renju double three, double four or overline of black
+     *
+     * The shapes of the four lines through the cell are cached until a stone is put or removed nearby,
+     * only double threes are confirmed recursively on every call.
+     * @param player stone of the move, eOO and any player of the other rules are never forbidden
+     * @param x coordinate of an empty cell
+     * @param y coordinate of an empty cell
+     */
+    [[nodiscard]] bool IsForbidden( eMove_t player, coord_t x, coord_t y );
+
+    /**
+     * @brief Shape of a player stone at x,y in one direction, updated incrementally, O(1)
+     * @param player eXX or eOO, the stone does not have to be on the desk
+     * @param x coordinate
+     * @param y coordinate
+     * @param dir index to kDirX, kDirY
+     */
+    [[nodiscard]] ePattern GetPattern( const eMove_t player, const coord_t x, const coord_t y,
+                                       const uint32_t dir ) const {
+        assert( x < m_DimX && y < m_DimY && dir < kDirCount );
+        return Pattern::FromCode( m_codes[PlayerIndex( player )][x * kBoardSize + y][dir] );
+    }
+
+    /**
+     * @brief Call f( x, y ) for all empty cells close to some stone, in x, y order
+     *
+     * The set is updated incrementally, the cost is O(candidates) instead of O(area).
+     * @param f callable( coord_t x, coord_t y )
+     */
+    template<typename F>
+    void ForEachCandidate( F f ) const { ForEachBit( m_candidates, f ); }
+
+    /**
+     * @brief Call f( x, y ) for all empty cells where the player makes at least the threat, in x, y order
+     * @param player eXX or eOO
+     * @param level threat bucket
+     * @param f callable( coord_t x, coord_t y )
+     */
+    template<typename F>
+    void ForEachThreat( const eMove_t player, const eThreat level, F f ) const {
+        ForEachBit( m_threats[PlayerIndex( player )][level], f );
+    }
+
+    /**
+     * @brief Test if the empty cell is close to some stone
+     */
+    [[nodiscard]] bool IsCandidate( const coord_t x, const coord_t y ) const {
+        return ( m_candidates[x] >> y ) & 1U;
+    }
+
     /**
      * @brief Put move on desk
      * @param m Move
      * @param player side to move
      */
-    void SetDesk( Move m, eMove_t player ) { m_desk[GetCoords( m )] = player; }
+    void SetDesk( Move m, eMove_t player ) { SetCell( GetCoords( m ), player ); }
     /**@}*/
 
     /**@{*/
@@ -116,21 +233,124 @@ public:
 
     [[nodiscard]] size_t GetGamePly() const { return m_gamePly; }
 
+    /**
+     * @brief Zobrist key of the position, stones and side to move, updated incrementally
+     */
+    [[nodiscard]] uint64_t GetKey() const { return m_key; }
+
+    /**
+     * @brief Symmetries of the board, 8 for a square, the 4 mirrors otherwise
+     */
+    [[nodiscard]] uint32_t GetSymmetryCount() const { return m_DimX == m_DimY ? kSymmetries : kSymmetries / 2U; }
+
+    /**
+     * @brief Cell of the transformed board
+     * @param symmetry 0..GetSymmetryCount() - 1, bit 2 swaps the axes, bits 0 and 1 mirror x and y after the swap
+     * @param x set to the cell
+     * @param y set to the cell
+     */
+    void Transform( const uint32_t symmetry, coord_t& x, coord_t& y ) const {
+        if(( symmetry & 4U ) != 0U ) {
+            std::swap( x, y );
+        }
+        if(( symmetry & 1U ) != 0U ) {
+            x = m_DimX - 1U - x;
+        }
+        if(( symmetry & 2U ) != 0U ) {
+            y = m_DimY - 1U - y;
+        }
+    }
+
+    /**
+     * @brief Inverse of Transform()
+     */
+    void InverseTransform( const uint32_t symmetry, coord_t& x, coord_t& y ) const {
+        if(( symmetry & 1U ) != 0U ) {
+            x = m_DimX - 1U - x;
+        }
+        if(( symmetry & 2U ) != 0U ) {
+            y = m_DimY - 1U - y;
+        }
+        if(( symmetry & 4U ) != 0U ) {
+            std::swap( x, y );
+        }
+    }
+
+    /**
+     * @brief Key of the stones of the transformed board, updated incrementally, the side to move is not included
+     * @param symmetry 0..GetSymmetryCount() - 1
+     * @param first stones of this player are hashed as the stones of the first player
+     */
+    [[nodiscard]] uint64_t GetSymmetryKey( const uint32_t symmetry, const eMove_t first ) const {
+        assert( symmetry < GetSymmetryCount());
+        const auto index = PlayerIndex( first );
+        return m_symKeys[index][symmetry] ^ Zobrist::SecondColour( m_symKeys[1U - index][symmetry] );
+    }
+
+    /**
+     * @brief Smallest symmetry key, equal for all rotations and reflections of the position
+     * @param first see GetSymmetryKey(), Board::GetBlack() makes the key independent of the colours
+     * @param symmetry set to the symmetry of the key, the first one if more give it
+     */
+    [[nodiscard]] uint64_t GetCanonicalKey( eMove_t first, uint32_t& symmetry ) const;
+
+    /**
+     * @brief Compute the symmetry key from scratch, O(area)
+     */
+    [[nodiscard]] uint64_t ComputeSymmetryKey( uint32_t symmetry, eMove_t first ) const;
+
+    /**
+     * @brief Key of the position after MakeMove( m ), the board is not changed
+     * @param m move coordinates and piece
+     */
+    [[nodiscard]] uint64_t GetKeyAfter( Move m ) const;
+
+    /**
+     * @brief Compute the position key from scratch, O(area)
+     */
+    [[nodiscard]] uint64_t ComputeKey() const;
+
+    /**
+     * @brief Verification of the incremental key, used by asserts in debug builds
+     */
+    [[nodiscard]] bool IsKeyConsistent() const { return m_key == ComputeKey(); }
+
     [[nodiscard]] inline eMove_t GetDesk( coord_t x, coord_t y ) const {
-        return m_desk[x * kBoardSize + y];
+        return GetCell( x * kBoardSize + y );
     }
 
-    [[nodiscard]] inline eMove_t GetDesk( Move m ) const { return m_desk[GetCoords( m )]; }
+    [[nodiscard]] inline eMove_t GetDesk( Move m ) const { return GetCell( GetCoords( m )); }
+
+    /**
+     * @brief Piece on desk, signed coordinates, eBlock outside of the playing area
+     * @param x coordinate
+     * @param y coordinate
+     */
+    [[nodiscard]] inline eMove_t GetDeskOrWall( int x, int y ) const {
+        // cells of the desk outside of the playing area are eBlock sentinels
+        if( static_cast<uint32_t>( x ) >= kMaxBoard || static_cast<uint32_t>( y ) >= kBoardSize ) {
+            return eMove_t::eBlock;
+        }
+        return GetDesk( static_cast<coord_t>( x ), static_cast<coord_t>( y ));
+    }
+
+    [[nodiscard]] Move GetLastMove() const {
+        return m_gamePly > 0 ? m_playedMoves[m_gamePly - 1] : MOVE_NONE;
+    }
     /**@}*/
 
     /**@{
      * @brief Other properties of the position
      */
-    void SwitchSideToMove() const { sideToMove = !sideToMove; }
+    void SwitchSideToMove();
 
     bool SideToMove() const { return sideToMove; }
 
-    void SetSideToMove( bool stm ) { sideToMove = stm; }
+    void SetSideToMove( bool stm ) {
+        if( stm != sideToMove ) {
+            SwitchSideToMove();
+        }
+    }
     /**@}*/
 
     /**@{
@@ -144,16 +364,174 @@ public:
     /**@} */
 
 private:
-    size_t        m_gamePly;                         /**< how many moves on the board */
-    const coord_t m_DimX;                            /**< board dimension X-axis */
-    const coord_t m_DimY;                            /**< board dimension Y-axis */
-    mutable bool  sideToMove;                        /**< player to move */
+    static constexpr int      kNearDist  = 2;                    /**< candidate cells are this close to a stone */
+
+    [[nodiscard]] static constexpr uint32_t PlayerIndex( eMove_t player ) {
+        return player == eMove_t::eXX ? 0U : 1U;
+    }
+
+    static constexpr uint32_t kCellBits     = 2U;                /**< eMove_t in the packed desk */
+    static constexpr uint32_t kCellsPerWord = 64U / kCellBits;   /**< one desk word is one column */
+
+    static_assert( kCellsPerWord == kBoardSize, "Desk word index is x" );
+
+    /**
+     * @brief Piece of the packed desk
+     * @param coords x * kBoardSize + y
+     */
+    [[nodiscard]] eMove_t GetCell( coords_t coords ) const {
+        return static_cast<eMove_t>(( m_desk[coords / kCellsPerWord] >>
+                                      ( kCellBits * ( coords % kCellsPerWord ))) & 3U );
+    }
+
+    /**
+     * @brief Store piece to the packed desk
+     * @param coords x * kBoardSize + y
+     * @param piece new content
+     */
+    void SetCell( coords_t coords, eMove_t piece ) {
+        const auto shift = kCellBits * ( coords % kCellsPerWord );
+        auto&      word  = m_desk[coords / kCellsPerWord];
+        word = ( word & ~( uint64_t{ 3U } << shift )) | ( static_cast<uint64_t>( piece ) << shift );
+    }
+
+    /**
+     * @brief Add or remove the stone in the line codes of the neighbours
+     * @tparam add true for a new stone
+     */
+    template<bool add>
+    void UpdateCodes( eMove_t player, coord_t x, coord_t y );
+
+    /**
+     * @brief Add or remove the stone in the keys of all symmetries, XOR is its own inverse
+     */
+    void UpdateSymmetryKeys( eMove_t player, coord_t x, coord_t y );
+
+    /**
+     * @brief Add or remove the stone in the near counts and in the candidate set
+     * @tparam add true for a new stone, called after the desk is updated
+     */
+    template<bool add>
+    void UpdateCandidates( coord_t x, coord_t y );
+
+    /**
+     * @brief Count a changed line pattern of the cell in the threat buckets
+     * @param player index of the player
+     * @param cell coordinates
+     * @param before pattern of the line before the change
+     * @param after pattern of the line after the change
+     */
+    void UpdateThreats( uint32_t player, coords_t cell, ePattern before, ePattern after );
+
+    /**
+     * @brief Set the threat bits of the cell after its stone was put or removed
+     */
+    void SyncThreats( coords_t cell );
 
-    eMove_t m_desk[kBoardSize * kMaxBoard];          /**< main board */
+    /**
+     * @brief Set or clear the cell in the threat bucket
+     */
+    void SetThreatBit( const uint32_t player, const uint32_t level, const coords_t cell, const bool set ) {
+        const auto bit = 1U << ( cell % kBoardSize );
+        auto&      col = m_threats[player][level][cell / kBoardSize];
+        col = set ? col | bit : col & ~bit;
+    }
+
+    /**
+     * @enum eForbid
+     * @brief Cached shape of the cell for a black stone
+     */
+    enum eForbid : uint8_t {
+        eForbidUnknown, /**< not computed since the last change nearby */
+        eForbidNo,      /**< five, or no double shape */
+        eForbidYes,     /**< overline or double four */
+        eForbidThrees   /**< double three, if both threes can become open fours */
+    };
+
+    static constexpr uint32_t kForbidDepth = 4U; /**< nested three checks, deeper threes are real */
+
+    /**
+     * @brief Cells of the line through x,y seen by the player, the centre is own
+     */
+    void GetWindow( eMove_t player, coord_t x, coord_t y, uint32_t dir, Renju::Window& w ) const;
+
+    /**
+     * @brief Shape of a black stone on the empty cell, the desk is not changed
+     */
+    [[nodiscard]] eForbid ClassifyForbidden( coord_t x, coord_t y ) const;
+
+    /**
+     * @brief Full check of the empty cell, stones of the outer checks are on the desk
+     * @param depth nesting level of the check
+     */
+    [[nodiscard]] bool IsForbiddenAt( coord_t x, coord_t y, uint32_t depth );
+
+    /**
+     * @brief Count threes of a black stone on x,y which can become open fours by allowed moves
+     */
+    [[nodiscard]] uint32_t CountRealThrees( coord_t x, coord_t y, uint32_t depth );
+
+    /**
+     * @brief Forget cached shapes of the cells sharing a line with x,y
+     */
+    void InvalidateForbidden( coord_t x, coord_t y );
+
+    /**
+     * @brief Index of the lowest set bit
+     * @param bits non zero mask
+     */
+    [[nodiscard]] static uint32_t LowestBit( const uint32_t bits ) {
+        assert( bits != 0U );
+#if defined( __GNUC__ ) || defined( __clang__ )
+        return static_cast<uint32_t>( __builtin_ctz( bits ));
+#else
+        auto index = 0U;
+        while(( bits & ( 1U << index )) == 0U ) {
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    /**
+     * @brief Call f( x, y ) for every set bit of the columns
+     */
+    template<typename F>
+    void ForEachBit( const uint32_t ( &columns )[kMaxBoard], F f ) const {
+        for( coord_t x = 0U; x < m_DimX; ++x ) {
+            for( auto bits = columns[x]; bits != 0U; bits &= bits - 1U ) {
+                f( x, static_cast<coord_t>( LowestBit( bits )));
+            }
+        }
+    }
+
+    // all members are flat arrays or scalars, copies are a memcpy
+    size_t        m_gamePly;                         /**< how many moves on the board */
+    uint64_t      m_key;                             /**< Zobrist key of the position */
+    coord_t       m_DimX;                            /**< board dimension X-axis */
+    coord_t       m_DimY;                            /**< board dimension Y-axis */
+    bool          sideToMove;                        /**< player to move, true for eXX */
+    size_t        m_winPly;                          /**< stones on the board after the first five, 0 if none */
+    uint32_t      m_stones[2];                       /**< stones of eXX and eOO */
+    uint64_t      m_symKeys[2][kSymmetries];         /**< Zobrist::CellKey() sums of eXX and eOO stones per symmetry */
+    eRule         m_rule;                            /**< game rule */
+    eMove_t       m_forbidBlack;                     /**< black stones of the cached shapes */
+
+    uint64_t m_desk[kMaxBoard];                      /**< main board, 2 bits per cell, eBlock outside */
     Move    m_playedMoves[kBoardSize * kPlaySize];   /**< already played moves in correct order */
+    uint64_t m_fives[( kBoardSize * kPlaySize + 63U ) / 64U]; /**< bit per played move, it completed a five */
+
+    uint16_t m_codes[2][kBoardSize * kMaxBoard][kDirCount]; /**< base 3 line codes of eXX and eOO */
+    uint8_t  m_near[kBoardSize * kMaxBoard];         /**< stones within kNearDist */
+    uint32_t m_candidates[kMaxBoard];                /**< empty cells with m_near > 0, bit y of column x */
+    uint32_t m_threats[2][eThreatCount][kMaxBoard];  /**< threat buckets of eXX and eOO, bit y of column x */
+    uint8_t  m_threatDirs[2][eThreatCount][kBoardSize * kMaxBoard]; /**< directions of the cell in the bucket */
+    uint8_t  m_forbid[kBoardSize * kMaxBoard];       /**< eForbid cache of renju */
 
 };
 
+static_assert( std::is_trivially_copyable_v<Board>, "Worker boards are cloned by memcpy" );
+
 inline bool Board::CheckCoords( const Move m ) const {
     return ( GetX( m ) < m_DimX ) && ( GetY( m ) < m_DimY );
 }
@@ -162,7 +540,7 @@ inline bool Board::CanMakeMove( const Move m ) const {
     assert( CheckCoords( m ));
     assert( !IsEmpty( m ));
 
-    return m_desk[GetCoords( m )] == eMove_t::eEmpty;
+    return GetCell( GetCoords( m )) == eMove_t::eEmpty;
 }
 
 #endif // BOARD_H
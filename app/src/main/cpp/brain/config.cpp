@@ -7,5 +7,6 @@
 #include <cassert>
 
 Config::Config() {
-    assert( SetTimeoutTurn( 0U ).GetTimeoutTurn() == 0U );
+    // the check does not set TIMEOUT_TURN, an unset 0 is not the fastest turn
+    assert( GetTimeoutTurn() == 0U && !IsTimeoutTurnSet());
 }
@@ -8,6 +8,9 @@
 
 #include "gameTypes.h"
 
+#include <algorithm>
+#include <string>
+
 /**
  * @class Config
  * @brief Configuration info, set of values
@@ -19,11 +22,31 @@ public:
 
     /**@{*/
     /** Setters */
+    Config& SetFolder( const std::string& folder )
+    {
+        m_folder = folder;
+        return *this;
+    }
+    Config& SetUseDatabase( bool use_database )
+    {
+        m_use_database = use_database;
+        return *this;
+    }
     Config& SetContinuous( int32_t continuous )
     {
         m_continuous = continuous;
         return *this;
     }
+    Config& SetPonder( bool ponder )
+    {
+        m_ponder = ponder;
+        return *this;
+    }
+    Config& SetPowerSave( bool power_save )
+    {
+        m_power_save = power_save;
+        return *this;
+    }
     Config& SetRule( int32_t rule )
     {
         m_rule = rule;
@@ -54,6 +77,11 @@ public:
         m_max_memory = ( max_memory == 0ULL ) ? kTTMemorySize : max_memory;
         return *this;
     }
+    Config& SetThreadNum( uint32_t thread_num )
+    {
+        m_thread_num = std::clamp( thread_num, 1U, kMaxThreads );
+        return *this;
+    }
     Config& SetTimeLeft( uint32_t time_left )
     {
         m_time_left = time_left;
@@ -71,7 +99,8 @@ public:
     }
     Config& SetTimeoutTurn( uint32_t timeout_turn )
     {
-        m_timeout_turn = timeout_turn;
+        m_timeout_turn     = timeout_turn;
+        m_timeout_turn_set = true;
         return *this;
     }
     Config& SetWidth( coord_t width )
@@ -84,16 +113,39 @@ public:
     /**@{*/
     /** Getters */
     [[nodiscard]] int32_t  GetContinuous() const { return m_continuous; }
+    [[nodiscard]] const std::string& GetFolder() const { return m_folder; }
+    [[nodiscard]] bool     GetUseDatabase() const { return m_use_database; }
     [[nodiscard]] int32_t  GetGameType() const { return m_game_type; }
     [[nodiscard]] coord_t  GetHeight() const { return m_height; }
     [[nodiscard]] uint32_t GetLimitDepth() const { return m_limit_depth; }
     [[nodiscard]] uint64_t GetLimitNodes() const { return m_limit_nodes; }
     [[nodiscard]] uint64_t GetMaxMemory() const { return m_max_memory; }
+    [[nodiscard]] bool     GetPonder() const { return m_ponder; }
+    [[nodiscard]] bool     GetPowerSave() const { return m_power_save; }
     [[nodiscard]] int32_t  GetRule() const { return m_rule; }
+
+    /**
+     * @brief Rule of the board, renju wins over the exact five bit
+     */
+    [[nodiscard]] eRule GetBoardRule() const {
+        return ( m_rule & eRuleRenju ) != 0 ? eRuleRenju : ( m_rule & eRuleExactFive ) != 0 ? eRuleExactFive
+                                                                                          : eRuleFreestyle;
+    }
+
+    /**
+     * @brief Search on the opponent's time, requested and not throttled
+     */
+    [[nodiscard]] bool IsPonderActive() const { return m_ponder && !m_power_save; }
+    [[nodiscard]] uint32_t GetThreadNum() const { return m_thread_num; }
     [[nodiscard]] uint32_t GetTimeLeft() const { return m_time_left; }
     [[nodiscard]] uint32_t GetTimeInc() const { return m_time_inc; }
     [[nodiscard]] uint32_t GetTimeoutMatch() const { return m_timeout_match; }
     [[nodiscard]] uint32_t GetTimeoutTurn() const { return m_timeout_turn; }
+
+    /**
+     * @brief TIMEOUT_TURN was set, its 0 asks for the fastest answer, an unset 0 is unknown
+     */
+    [[nodiscard]] bool IsTimeoutTurnSet() const { return m_timeout_turn_set; }
     [[nodiscard]] coord_t  GetWidth() const { return m_width; }
     /**@}*/
 
@@ -105,9 +157,15 @@ private:
     uint64_t m_max_memory { kTTMemorySize }; /**< maximum memory in bytes, zero if unlimited */
     uint32_t m_limit_depth { 28U };          /**< search depth in plys */
     uint64_t m_limit_nodes { 0U };           /**< search limit in nodes searched */
+    uint32_t m_thread_num { 1U };            /**< search threads */
     int32_t  m_game_type { 0 };              /**< 0:human, 1:AI opponent, 2:tournament, 3:network tournament */
-    int32_t  m_rule { 0 };                   /**< 0:five or more stones win, 1:exactly five stones win, 4:renju */
+    int32_t  m_rule { 0 };                   /**< bits 1:exactly five stones win, 2:continuous, 4:renju */
     int32_t  m_continuous { 0 };             /**< 0:single game, 1:continuous */
+    bool     m_ponder { false };             /**< search the expected reply on the opponent's time */
+    bool     m_power_save { false };         /**< battery saver or thermal throttling, no pondering */
+    bool     m_use_database { false };       /**< play from the opening book in m_folder */
+    bool     m_timeout_turn_set { false };   /**< TIMEOUT_TURN came from the manager */
+    std::string m_folder;                    /**< persistent folder of the brain, case sensitive */
     coord_t  m_width { 20U };                /**< the board size */
     coord_t  m_height { 20U };               /**< the board size */
 };
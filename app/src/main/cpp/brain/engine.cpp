@@ -9,33 +9,92 @@
 
 #include "engine.h"
 #include "board.h"
+#include "keywords.h"
+#include "lazySmp.h"
+#include "log.h"
 #include "safecast.h"
-
-#include <android/log.h>
+#include "timeManager.h"
 
 Engine::Engine( const uint32_t boardSize ) :
-        m_info(), m_queueIn(), m_queueOut(), m_infoWidth( boardSize ),
+        m_info(), m_tt( GetCacheBudget()), m_vcf( GetCacheBudget()), m_vct( GetCacheBudget()), m_queueIn(), m_queueOut(), m_infoWidth( boardSize ),
         m_infoHeight( boardSize ) {
     Util::rand_xor128_seed();
+
+    // pipeOut() formats into these, the reader returns them by ReadFromOutputQueue( line, timeout )
+    for( auto i = 0U; i < kFreeLines / 2U; ++i ) {
+        std::string line;
+        line.reserve( kLineCapacity );
+        m_queueFree.push( std::move( line ));
+    }
+    m_LastPipeOut.reserve( kLineCapacity );
+    m_formatLine.reserve( kLineCapacity );
 }
 
 Engine::~Engine() {
+    // later lines are dropped, a writer waiting for a slot gets one
+    m_closing = true;
+    m_queueOut.clear();
     StopLoop();
     if( m_runner.joinable()) {
         m_runner.join();
     }
+    WaitForSearch( true );
 }
 
 /******************************
- * Implement this function
+ * Forced win by continuous fours or threats first, then
+ * iterative deepening search limited by INFO MAX_DEPTH, MAX_NODE and the time manager,
+ * INFO THREAD_NUM threads
  * @return best possible move
  */
 Move Engine::CalculateMove() {
-    return m_board->GenerateRandomMove<eMove_t::eXX>();
+    const TimeManager time( m_info, m_board->GetGamePly());
+
+    auto limits  = SearchLimits{};
+    limits.depth = m_info.GetLimitDepth();
+    limits.nodes = m_info.GetLimitNodes();
+
+    // the brain always plays eXX stones
+    m_board->SetSideToMove( true );
+
+    // book moves cost no search time
+    const auto book = m_book.Probe( *m_board );
+    if( IsOk( book ) && !m_board->IsForbidden( eMove_t::eXX, GetX( book ), GetY( book ))) {
+        pipeOutMessage( "BOOK" );
+        return book;
+    }
+
+    limits.abort = &m_stopSearch;
+
+    const auto vcf = m_vcf.Solve( *m_board, Vcf::kRootNodes, limits.abort );
+    if( IsOk( vcf )) {
+        pipeOutMessage( "VCF N ", m_vcf.GetNodes());
+        return vcf;
+    }
+
+    const auto vct = m_vct.Solve( *m_board, std::max( time.RemainingSoftMs() / Vct::kTimeShare, 1U ), 0U,
+                                  limits.abort );
+    if( IsOk( vct )) {
+        m_formatLine.clear();
+        for( const auto m : m_vct.GetMainLine()) {
+            Util::Append( m_formatLine, ' ', GetX( m ), ',', GetY( m ));
+        }
+        pipeOutMessage( "VCT N ", m_vct.GetNodes(), m_formatLine );
+        return vct;
+    }
+
+    limits.timeMs = time.RemainingHardMs();
+    limits.softMs = time.RemainingSoftMs();
+
+    LazySmp search( *m_board, m_tt, m_info.GetThreadNum());
+    return search.Think( limits, [this]( const SearchInfo& info ) {
+        pipeOutMessage( "DEPTH ", info.depth, " EV ", info.score, " N ", info.nodes, " N/MS ",
+                        info.nodes / std::max<uint64_t>( info.timeMs, 1U ));
+    } );
 }
 
 /******************************
- * Implement this function
+ * Winner of the first five, black also loses by a forbidden move in renju
  * Possible answers:
  * "RESULT NONE"
  * "RESULT BLACK"
@@ -43,7 +102,23 @@ Move Engine::CalculateMove() {
  * "RESULT DRAW"
  */
 void Engine::CmdResult() const {
-    if( m_board->IsFull()) {
+    const auto black  = m_board->GetBlack();
+    auto       winner = m_board->GetWinner();
+    if( winner == eMove_t::eEmpty && m_board->GetRule() == eRuleRenju && m_board->GetGamePly() > 0U ) {
+        // the position before the move decides, the live board is not touched
+        const auto last   = m_board->GetLastMove();
+        const auto before = std::make_unique<Board>( *m_board );
+        before->UndoMove( last );
+        // BOARD sets the side to move, the undo could hand the move to the other side
+        before->SetSideToMove( IsTypeXX( last ));
+        if( before->IsForbidden( GetType( last ), GetX( last ), GetY( last ))) {
+            winner = GetOpponent( GetType( last ));
+        }
+    }
+
+    if( winner != eMove_t::eEmpty ) {
+        pipeOutMessage( winner == black ? "RESULT BLACK" : "RESULT WHITE" );
+    } else if( m_board->IsFull()) {
         pipeOutMessage( "RESULT DRAW" );
     } else {
         pipeOutMessage( "RESULT NONE" );
@@ -51,18 +126,27 @@ void Engine::CmdResult() const {
 }
 
 Engine& Engine::AddCommandsToInputQueue( const std::string& LastCommand ) {
-    __android_log_write( ANDROID_LOG_DEBUG, "AddCommandsToInputQueue", LastCommand.c_str());
-    auto res = Util::StringToUpper( LastCommand );
-
-    for( size_t posToken = 0U; ( posToken = res.find( '\n' )) != std::string::npos; ) {
-        const auto oneLine = res.substr( 0, posToken );
-        if( !oneLine.empty()) {
-            m_queueIn.push( oneLine );
+    BRAIN_LOG( ANDROID_LOG_DEBUG, "AddCommandsToInputQueue", LastCommand );
+    // lines keep their case, keywords are parsed in any case and FOLDER keeps its path
+    auto rest = std::string_view( LastCommand );
+
+    // the lines of one call stay together
+    auto dropped = 0U;
+    {
+        const auto lock = std::unique_lock<std::mutex>( m_inputMutex );
+        while( !rest.empty()) {
+            const auto posToken = rest.find( '\n' );
+            const auto oneLine  = rest.substr( 0, posToken );
+            // a full queue drops the rest, waiting here would block StopLoop() on the mutex
+            if( !oneLine.empty() && ( dropped > 0U || !m_queueIn.try_push( std::string( oneLine )))) {
+                ++dropped;
+            }
+            rest.remove_prefix( posToken == std::string_view::npos ? rest.size() : posToken + 1 );
         }
-        res.erase( 0, posToken + 1 );
     }
-    if( !res.empty()) {
-        m_queueIn.push( res );
+    if( dropped > 0U ) {
+        BRAIN_LOG( ANDROID_LOG_ERROR, "AddCommandsToInputQueue", "full, dropped ", dropped );
+        pipeOut( "ERROR input queue full, ", dropped, " lines dropped" );
     }
     return *this;
 }
@@ -71,7 +155,7 @@ bool Engine::Loop() {
     m_loopIsRunning = true;
     while( CmdExecute( ReadInputLine())) {
     }
-    __android_log_write( ANDROID_LOG_DEBUG, "Loop", "" );
+    BRAIN_LOG( ANDROID_LOG_DEBUG, "Loop", "" );
     m_loopIsRunning = false;
     return true;
 }
@@ -80,58 +164,73 @@ std::string Engine::ReadInputLine() {
     return m_queueIn.pop( 0 );
 }
 
-void Engine::WriteOutputLine( const std::string& data ) const {
-    m_queueOut.push( data );
+void Engine::WriteOutputLine( std::string&& data, const bool droppable ) const {
+    if( !droppable && !m_closing ) {
+        m_queueOut.push( std::move( data ));
+    } else if( !m_queueOut.try_push( std::move( data ))) {
+        ++m_droppedLines;
+        BRAIN_LOG( ANDROID_LOG_DEBUG, "WriteOutputLine", "full, dropped ", m_droppedLines );
+    }
 }
 
-Engine::eCommand Engine::ParseCmd( const std::string& s, std::string& rest ) {
-    rest                = "";
-    using eCommandVector = std::vector<std::pair<std::string, Engine::eCommand>>;
-    const auto keywords = eCommandVector{{ "ABOUT",        eCommand::eAbout },
-                                         { "BEGIN",        eCommand::eBegin },
-                                         { "END",          eCommand::eEnd },
-                                         { "TURN",         eCommand::eTurn },
-                                         { "TAKEBACK",     eCommand::eTakeback },
-                                         { "BOARD",        eCommand::eBoard },
-                                         { "PLAY",         eCommand::ePlay },
-                                         { "START",        eCommand::eStart },
-                                         { "RESTART",      eCommand::eRestart },
-                                         { "INFO",         eCommand::eInfo },
-                                         { "YXBOARD",      eCommand::eYxBoard },
-                                         { "YXRESULT",     eCommand::eAnResult },
-                                         { "YXSHOWFORBID", eCommand::eYxShowForbid },
-                                         { "YXSTOP",       eCommand::eYxStop }};
-
-    __android_log_write( ANDROID_LOG_VERBOSE, "Parse", s.c_str());
+namespace {
+    /**
+     * @brief First word of a line and the trimmed rest
+     */
+    std::string_view SplitWord( const std::string_view s, std::string_view& rest ) {
+        const auto pos = s.find_first_of( " \t" );
+        rest = pos == std::string_view::npos ? std::string_view{} : Util::TrimView( s.substr( pos ));
+        return s.substr( 0, pos );
+    }
 
-    const auto it = std::find_if( std::begin( keywords ), std::end( keywords ),
-                                  [s]( const auto& a ) {
-                                      auto nPos = size_t{ 0 };
-                                      return (( nPos = s.find( a.first )) != std::string::npos ) &&
-                                             ( nPos == 0 ) &&
-                                             ( s.length() == a.first.length() ||
-                                               s[a.first.length()] == ' ' );
-                                  } );
+    /**
+     * @brief Line ending the stones of BOARD and YXBOARD, in any case
+     */
+    bool IsDone( const std::string_view s ) {
+        return Keywords::EqualsUpper( Util::TrimView( s ), "DONE" );
+    }
+}
 
-    if( it != std::end( keywords )) {
-        rest = Util::Trim( s.substr( it->first.length()));
-        return it->second;
+Engine::eCommand Engine::ParseCmd( const std::string_view s, std::string_view& rest ) {
+    using Keyword = Keywords::Keyword<eCommand>;
+    static constexpr Keyword kCommandList[] = {{ "ABOUT",        eCommand::eAbout },
+                                               { "BEGIN",        eCommand::eBegin },
+                                               { "END",          eCommand::eEnd },
+                                               { "TURN",         eCommand::eTurn },
+                                               { "TAKEBACK",     eCommand::eTakeback },
+                                               { "BOARD",        eCommand::eBoard },
+                                               { "PLAY",         eCommand::ePlay },
+                                               { "START",        eCommand::eStart },
+                                               { "RESTART",      eCommand::eRestart },
+                                               { "INFO",         eCommand::eInfo },
+                                               { "YXBOARD",      eCommand::eYxBoard },
+                                               { "YXRESULT",     eCommand::eAnResult },
+                                               { "YXSHOWFORBID", eCommand::eYxShowForbid },
+                                               { "YXSTOP",       eCommand::eYxStop }};
+    static constexpr Keywords::Table<eCommand> kCommands( kCommandList, eCommand::eUnknown );
+    static_assert( kCommands.IsPerfect(), "command keywords share a hash slot" );
+
+    const auto cmd = kCommands.Find( SplitWord( s, rest ));
+    if( cmd == eCommand::eUnknown ) {
+        rest = {};
     }
-    return eCommand::eUnknown;
+    return cmd;
 }
 
 bool Engine::CmdExecute( const std::string& cmd ) {
-    const auto tmpUpper = Util::StringToUpper( cmd );
-    __android_log_write( ANDROID_LOG_DEBUG, "Exec", cmd.c_str());
-    std::string rest;
-    const auto  eCmd    = ParseCmd( tmpUpper, rest );
+    BRAIN_LOG( ANDROID_LOG_DEBUG, "Exec", cmd );
+    std::string_view rest;
+    const auto       eCmd = ParseCmd( cmd, rest );
 
     if( m_bInSearch &&
         ( eCmd != eCommand::eEnd && eCmd != eCommand::eYxStop )) {
-        pipeOutMessage( ": BAD COMMAND ", tmpUpper.c_str(), " IN SEARCH MODE" );
+        pipeOutMessage( ": BAD COMMAND ", cmd, " IN SEARCH MODE" );
         return true;
     }
 
+    // any command ends pondering, a following TURN finds its results in the cache
+    StopPonder();
+
     auto bLoop = true;
 
     switch( eCmd ) {
@@ -149,9 +248,11 @@ bool Engine::CmdExecute( const std::string& cmd ) {
             CmdTurn();
             break;
         case eCommand::eEnd:
+            WaitForSearch( true );
             bLoop = false;
             break;
         case eCommand::eInfo:
+            // the trimmed parameters in their original case
             CmdParseInfo( rest );
             break;
         case eCommand::ePlay:
@@ -159,6 +260,8 @@ bool Engine::CmdExecute( const std::string& cmd ) {
             break;
         case eCommand::eRestart:
             m_board->Reset();
+            m_ponderKey = 0U;
+            m_vcf.Clear();
             pipeOut( "OK" );
             break;
         case eCommand::eStart:
@@ -178,9 +281,11 @@ bool Engine::CmdExecute( const std::string& cmd ) {
             CmdShowForbid();
             break;
         case eCommand::eYxStop:
+            // the worker answers the best move so far
+            m_stopSearch = true;
             break;
         case eCommand::eUnknown:
-            pipeOut( "UNKNOWN ", tmpUpper.c_str());
+            pipeOut( "UNKNOWN ", cmd );
             break;
     }
     return bLoop;
@@ -194,14 +299,33 @@ std::string Engine::ReadFromOutputQueue( int timeOutMs ) {
     return m_queueOut.pop( timeOutMs );
 }
 
+bool Engine::ReadFromOutputQueue( std::string& line, const int timeOutMs ) {
+    auto next = m_queueOut.pop( timeOutMs );
+    if( next.empty()) {
+        line.clear();
+        return false;
+    }
+    std::swap( line, next );
+
+    // only the reader adds buffers, the checked push never waits for a free slot
+    if( next.capacity() >= kLineCapacity && m_queueFree.count() < kFreeLines ) {
+        next.clear();
+        m_queueFree.push( std::move( next ));
+    }
+    return true;
+}
+
 void Engine::StartLoop() {
     if( !m_loopIsRunning ) {
+        m_loopIsRunning = true;
         m_runner = std::thread( &Engine::Loop, this );
     }
 }
 
 void Engine::StopLoop() {
     if( m_loopIsRunning ) {
+        // the running loop frees a slot
+        const auto lock = std::unique_lock<std::mutex>( m_inputMutex );
         m_queueIn.push( "end" );
     }
 }
@@ -212,15 +336,89 @@ void Engine::CmdAbout() const {
 
 void Engine::CmdTurn() {
     if( !m_board->IsFull()) {
-        const auto m = CalculateMove();
-        CmdPutMyMove( GetX( m ), GetY( m ));
-        pipeOut( GetX( m ), ",", GetY( m ));
+        WaitForSearch( false );
+        if( m_ponderKey != 0U ) {
+            m_board->SetSideToMove( true );
+            if( m_board->GetKey() == m_ponderKey ) {
+                pipeOutMessage( "PONDER HIT DEPTH ", m_ponderDepth );
+            } else {
+                pipeOutMessage( "PONDER MISS" );
+            }
+            m_ponderKey = 0U;
+        }
+
+        m_stopSearch = false;
+        m_bInSearch  = true;
+        // the loop keeps reading commands, the board is not changed until the search ends
+        m_searcher = std::thread( [this]() {
+            const auto m = CalculateMove();
+            CmdPutMyMove( GetX( m ), GetY( m ));
+
+            // the board is copied before the loop can change it
+            auto ponder = m_info.IsPonderActive() && !m_stopSearch ? PonderBoard() : nullptr;
+            // the reply can come as soon as the move is read, the loop must accept it
+            m_pondering = ponder != nullptr;
+            m_bInSearch = false;
+            pipeOut( GetX( m ), ",", GetY( m ));
+            if( ponder ) {
+                Ponder( *ponder );
+            }
+        } );
     } else {
         pipeOutMessage( "RESULT DRAW" );
         pipeOut( "ERROR Full board" );
     }
 }
 
+std::unique_ptr<Board> Engine::PonderBoard() {
+    // the expected reply is the best move of the cache after own move
+    auto tte = TTEntry{};
+    if( m_board->IsFull() || m_board->IsLastMoveFive() || !m_tt.Probe( m_board->GetKey(), tte ) ||
+        !tte.hasMove ) {
+        return nullptr;
+    }
+    const auto reply = createMove<eMove_t::eOO>( tte.x, tte.y );
+    if( !m_board->CheckCoords( reply ) || !m_board->CanMakeMove( reply )) {
+        return nullptr;
+    }
+
+    auto board = std::make_unique<Board>( *m_board );
+    board->MakeMove( reply );
+    if( board->IsLastMoveFive() || board->IsFull()) {
+        return nullptr;
+    }
+    m_ponderMove  = reply;
+    m_ponderKey   = board->GetKey();
+    m_ponderDepth = 0U;
+    return board;
+}
+
+void Engine::Ponder( Board& board ) {
+    auto limits  = SearchLimits{};
+    limits.depth = m_info.GetLimitDepth();
+    limits.abort = &m_stopSearch;
+
+    LazySmp search( board, m_tt, m_info.GetThreadNum());
+    static_cast<void>( search.Think( limits ));
+    m_ponderDepth = search.GetInfo().depth;
+}
+
+void Engine::StopPonder() {
+    if( m_pondering ) {
+        WaitForSearch( true );
+        m_pondering = false;
+    }
+}
+
+void Engine::WaitForSearch( const bool stop ) {
+    if( m_searcher.joinable()) {
+        if( stop ) {
+            m_stopSearch = true;
+        }
+        m_searcher.join();
+    }
+}
+
 void Engine::CmdPutMyMove( const coord_t x, const coord_t y ) {
     if( !CmdPutMove<eMove_t::eXX>( x, y )) {
         pipeOut( "ERROR my move [", x, ",", y, "]" );
@@ -254,27 +452,27 @@ Engine::CmdUndoMove( const coord_t x, const coord_t y, const eMove_t type, const
 template<eMove_t player>
 bool Engine::CmdPutMove( const coord_t x, const coord_t y ) {
     static_assert( player == eMove_t::eXX || player == eMove_t::eOO, "Bad player" );
+    // coordinates are checked before packing to the move
+    if( x >= m_board->GetDimX() || y >= m_board->GetDimY()) {
+        pipeOutDebug( "check move [", x, ",", y, "]" );
+        return false;
+    }
     const auto m = createMove<player>( x, y );
 
-    if( m_board->CheckCoords( m ) && m_board->CanMakeMove( m )) {
+    if( m_board->CanMakeMove( m )) {
         m_board->MakeMove( m );
         return true;
     }
-    if( !m_board->CheckCoords( m )) {
-        pipeOutDebug( "check move [", x, ",", y, "]" );
-    } else if( !m_board->CanMakeMove( m )) {
-        pipeOutDebug( "make move [", x, ",", y, "] = ", m_board->GetDesk( x, y ));
-    }
-
+    pipeOutDebug( "make move [", x, ",", y, "] = ", m_board->GetDesk( x, y ));
     return false;
 }
 
-void Engine::CmdParseStart( const std::string& params ) {
+void Engine::CmdParseStart( const std::string_view params ) {
     const auto&& v = Util::ParseNumbers( params, "," );
 
     if( v.size() == 1 ) {
         if( v[0] < 5 || static_cast<uint32_t>( v[0] ) > kPlaySize ) {
-            __android_log_write( ANDROID_LOG_INFO, "size [0]=", params.c_str());
+            BRAIN_LOG( ANDROID_LOG_INFO, "size [0]=", params );
             pipeOut( "ERROR size of the board" );
             return;
         }
@@ -282,7 +480,7 @@ void Engine::CmdParseStart( const std::string& params ) {
         return;
     }
 
-    __android_log_write( ANDROID_LOG_INFO, "size [0]=", params.c_str());
+    BRAIN_LOG( ANDROID_LOG_INFO, "size [0]=", params );
     pipeOut( "ERROR size of the board" );
 }
 
@@ -296,16 +494,20 @@ void Engine::CmdRectStart( const coord_t sizeX, const coord_t sizeY ) {
     m_infoHeight = sizeY;
 
     m_board = std::make_unique<Board>( m_infoWidth, m_infoHeight );
+    m_board->SetRule( m_info.GetBoardRule());
+    m_vcf.Clear();
+    m_ponderKey = 0U;
     pipeOut( "OK" );
 }
 
 void Engine::CmdParseBoard( bool flipSides ) {
     m_board = std::make_unique<Board>( m_infoWidth, m_infoHeight );
+    m_board->SetRule( m_info.GetBoardRule());
 
     auto firstMove = true;
     while( true ) {
         const auto&& s = ReadInputLine();
-        if( s.find( "DONE" ) != std::string::npos ) {
+        if( IsDone( s )) {
             m_board->SetSideToMove( true );
             break;
         }
@@ -326,7 +528,7 @@ void Engine::CmdParseBoard( bool flipSides ) {
                 break;
             }
         } else {
-            if( s.find( "DONE" ) == std::string::npos ) {
+            if( !IsDone( s )) {
                 pipeOut( "ERROR x,y,who or DONE expected after BOARD" );
             }
             break;
@@ -336,34 +538,55 @@ void Engine::CmdParseBoard( bool flipSides ) {
 }
 
 void Engine::CmdShowForbid() {
+    // Yixin format, two digits per coordinate, e.g. FORBID 07080911.
+    const auto twoDigits = [this]( const coord_t c ) {
+        Util::Append( m_formatLine, c < 10U ? "0" : "", c );
+    };
+    const auto black = m_board->GetBlack();
+
+    m_formatLine.clear();
+    for( coord_t x = 0U; x < m_board->GetDimX(); ++x ) {
+        for( coord_t y = 0U; y < m_board->GetDimY(); ++y ) {
+            if( m_board->GetDesk( x, y ) == eMove_t::eEmpty && m_board->IsForbidden( black, x, y )) {
+                twoDigits( x );
+                twoDigits( y );
+            }
+        }
+    }
+    pipeOut( "FORBID ", m_formatLine, "." );
 }
 
-std::string Engine::ParseInfo( const std::string& s, std::string& rest ) {
-    rest                    = "";
-    const auto infoKeywords =
-                       std::vector<std::string>{ "TIMEOUT_MATCH", "TIMEOUT_TURN", "TIME_LEFT",
-                                                 "TIME_INCREMENT", "GAME_TYPE", "RULE", "FOLDER",
-                                                 "MAX_MEMORY", "MAX_DEPTH", "MAX_NODE",
-                                                 "THREAD_NUM", "USEDATABASE" };
-
-    const auto it = std::find_if( std::begin( infoKeywords ), std::end( infoKeywords ),
-                                  [s]( const auto& a ) {
-                                      auto nPos = size_t{ 0 };
-                                      return (( nPos = s.find( a )) != std::string::npos ) &&
-                                             ( nPos == 0 );
-                                  } );
-
-    if( it != std::end( infoKeywords )) {
-        rest = Util::Trim( s.substr( it->length()));
-        return *it;
-    }
-    return "";
+Engine::eInfoKey Engine::ParseInfo( const std::string_view s, std::string_view& rest ) {
+    using Keyword = Keywords::Keyword<eInfoKey>;
+    static constexpr Keyword kInfoList[] = {{ "TIMEOUT_MATCH",  eInfoKey::eTimeoutMatch },
+                                            { "TIMEOUT_TURN",   eInfoKey::eTimeoutTurn },
+                                            { "TIME_LEFT",      eInfoKey::eTimeLeft },
+                                            { "TIME_INCREMENT", eInfoKey::eTimeIncrement },
+                                            { "GAME_TYPE",      eInfoKey::eGameType },
+                                            { "RULE",           eInfoKey::eRule },
+                                            { "FOLDER",         eInfoKey::eFolder },
+                                            { "MAX_MEMORY",     eInfoKey::eMaxMemory },
+                                            { "MAX_DEPTH",      eInfoKey::eMaxDepth },
+                                            { "MAX_NODE",       eInfoKey::eMaxNode },
+                                            { "THREAD_NUM",     eInfoKey::eThreadNum },
+                                            { "USEDATABASE",    eInfoKey::eUseDatabase },
+                                            { "PONDER",         eInfoKey::ePonder },
+                                            { "POWER_SAVE",     eInfoKey::ePowerSave }};
+    static constexpr Keywords::Table<eInfoKey> kInfo( kInfoList, eInfoKey::eUnknown );
+    static_assert( kInfo.IsPerfect(), "INFO keywords share a hash slot" );
+
+    return kInfo.Find( SplitWord( s, rest ));
 }
 
-void Engine::CmdParseInfo( const std::string& params ) {
-    std::string rest;
-    const auto&& ii = ParseInfo( params, rest );
-    if( ii.empty()) {
+void Engine::CmdParseInfo( const std::string_view params ) {
+    std::string_view rest;
+    const auto       ii = ParseInfo( params, rest );
+    if( ii == eInfoKey::eUnknown ) {
+        return;
+    }
+    if( ii == eInfoKey::eFolder ) {
+        m_info.SetFolder( std::string( rest ));
+        OpenBook();
         return;
     }
     const auto&& v = Util::ParseNumbers( rest, " " );
@@ -371,34 +594,99 @@ void Engine::CmdParseInfo( const std::string& params ) {
         return;
     }
 
-    if( ii == "TIMEOUT_MATCH" ) {
-        m_info.SetTimeoutMatch( safe_cast<uint32_t>( v[0] ));
-    } else if( ii == "TIMEOUT_TURN" ) {
-        m_info.SetTimeoutTurn( safe_cast<uint32_t>( v[0] ));
-    } else if( ii == "TIME_LEFT" ) {
-        m_info.SetTimeLeft( safe_cast<uint32_t>( v[0] ));
-    } else if( ii == "TIME_INCREMENT" ) {
-        m_info.SetTimeInc( safe_cast<uint32_t>( v[0] ));
-    } else if( ii == "GAME_TYPE" ) {
-        m_info.SetGameType( safe_cast<int>( v[0] ));
-    } else if( ii == "RULE" ) {
-    } else if( ii == "FOLDER" ) {
-    } else if( ii == "MAX_MEMORY" ) {
-        if( v[0] >= 0 ) {
-            m_info.SetMaxMemory( safe_cast<uint64_t>( v[0] ));
-        }
-    } else if( ii == "MAX_DEPTH" ) {
-        m_info.SetLimitDepth( safe_cast<uint32_t>( v[0] ));
-    } else if( ii == "MAX_NODE" ) {
-        m_info.SetLimitNodes( safe_cast<uint64_t>( v[0] ));
-    } else if( ii == "USEDATABASE" ) {
-    } else if( ii == "THREAD_NUM" ) {
-    } else {
+    switch( ii ) {
+        case eInfoKey::eTimeoutMatch:
+            m_info.SetTimeoutMatch( safe_cast<uint32_t>( v[0] ));
+            break;
+        case eInfoKey::eTimeoutTurn:
+            m_info.SetTimeoutTurn( safe_cast<uint32_t>( v[0] ));
+            break;
+        case eInfoKey::eTimeLeft:
+            m_info.SetTimeLeft( safe_cast<uint32_t>( v[0] ));
+            break;
+        case eInfoKey::eTimeIncrement:
+            m_info.SetTimeInc( safe_cast<uint32_t>( v[0] ));
+            break;
+        case eInfoKey::eGameType:
+            m_info.SetGameType( safe_cast<int>( v[0] ));
+            break;
+        case eInfoKey::eRule:
+            // bits 1:exactly five, 2:continuous game, 4:renju
+            m_info.SetRule( safe_cast<int32_t>( v[0] )).SetContinuous(( v[0] & 2 ) != 0 ? 1 : 0 );
+            if( m_board && m_info.GetBoardRule() != m_board->GetRule()) {
+                m_board->SetRule( m_info.GetBoardRule());
+                m_vcf.Clear();
+                m_tt.Clear();
+            }
+            break;
+        case eInfoKey::eMaxMemory:
+            if( v[0] >= 0 ) {
+                m_info.SetMaxMemory( safe_cast<uint64_t>( v[0] ));
+                ResizeCaches();
+            }
+            break;
+        case eInfoKey::eMaxDepth:
+            m_info.SetLimitDepth( safe_cast<uint32_t>( v[0] ));
+            break;
+        case eInfoKey::eMaxNode:
+            m_info.SetLimitNodes( safe_cast<uint64_t>( v[0] ));
+            break;
+        case eInfoKey::eUseDatabase:
+            m_info.SetUseDatabase( v[0] != 0 );
+            OpenBook();
+            break;
+        case eInfoKey::ePonder:
+            m_info.SetPonder( v[0] != 0 );
+            break;
+        case eInfoKey::ePowerSave:
+            // battery saver or thermal throttling requested by the GUI
+            m_info.SetPowerSave( v[0] != 0 );
+            break;
+        case eInfoKey::eThreadNum:
+            // used from the next turn
+            if( v[0] >= 0 ) {
+                const auto threads = m_info.GetThreadNum();
+                m_info.SetThreadNum( safe_cast<uint32_t>( std::min<int64_t>( v[0], kMaxThreads )));
+                if( m_info.GetThreadNum() != threads ) {
+                    // every thread takes a board from the budget
+                    ResizeCaches();
+                }
+            }
+            break;
+        case eInfoKey::eFolder:
+        case eInfoKey::eUnknown:
+            break;
     }
+}
+
+uint64_t Engine::GetReservedMemory() const {
+    // the search copies of the board, the ponder board and the board of the result check
+    const auto boards = uint64_t{ m_info.GetThreadNum() } + 2U;
+    return sizeof( Engine ) + kFreeLines * kLineCapacity + boards * ( sizeof( Board ) + sizeof( Search ));
+}
 
+uint64_t Engine::GetCacheBudget() const {
+    const auto reserved = GetReservedMemory();
+    return m_info.GetMaxMemory() > reserved ? m_info.GetMaxMemory() - reserved : 0U;
+}
+
+void Engine::ResizeCaches() {
+    // the shares of 1/2, 1/4 and 1/8 leave the rest of the budget free
+    const auto budget = GetCacheBudget();
+    m_tt.Resize( budget );
+    m_vct.Resize( budget );
+    m_vcf.Resize( budget );
+}
+
+void Engine::OpenBook() {
+    if( m_info.GetUseDatabase() && !m_info.GetFolder().empty()) {
+        m_book.Open( m_info.GetFolder() + "/" + OpeningBook::kFileName );
+    } else {
+        m_book.Close();
+    }
 }
 
-std::optional<std::vector<int64_t>> Engine::CmdParseCoords( const std::string& params ) {
+std::optional<Util::Numbers> Engine::CmdParseCoords( const std::string_view params ) {
     const auto v = Util::ParseNumbers( params, "," );
 
     if( v.size() != 2 || static_cast<uint32_t>( v[0] ) >= m_infoWidth ||
@@ -409,20 +697,20 @@ std::optional<std::vector<int64_t>> Engine::CmdParseCoords( const std::string& p
     return std::make_optional( v );
 }
 
-void Engine::CmdParsePlay( const std::string& params ) {
+void Engine::CmdParsePlay( const std::string_view params ) {
     if( const auto v = CmdParseCoords( params )) {
         CmdPutMyMove( static_cast<uint32_t>( v.value()[0] ), static_cast<uint32_t>( v.value()[1] ));
     }
 }
 
-void Engine::CmdParseTurn( const std::string& params ) {
+void Engine::CmdParseTurn( const std::string_view params ) {
     if( const auto v = CmdParseCoords( params )) {
         CmdPutYourMove( static_cast<uint32_t>( v.value()[0] ),
                         static_cast<uint32_t>( v.value()[1] ));
     }
 }
 
-void Engine::CmdParseTakeback( const std::string& params ) {
+void Engine::CmdParseTakeback( const std::string_view params ) {
     if( const auto v = CmdParseCoords( params )) {
         CmdUndoMove( static_cast<uint32_t>( v.value()[0] ), static_cast<uint32_t>( v.value()[1] ),
                      eMove_t::eXX, true );
@@ -8,10 +8,18 @@
 
 #include "gameTypes.h"
 #include "config.h"
-#include "lockedQueue.h"
+#include "log.h"
+#include "spscQueue.h"
+#include "openingBook.h"
+#include "transpositionTable.h"
+#include "vcf.h"
+#include "vct.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <sstream>
 #include <iostream>
 #include <optional>
 
@@ -47,18 +55,40 @@ public:
         eYxStop              // Yixin protocol enhancement
     };
 
+    static constexpr uint32_t kInputLines  = 1024U; /**< input lines waiting for the loop, power of 2 */
+    static constexpr uint32_t kOutputLines = 1024U; /**< output lines waiting for the reader, power of 2 */
+
     /**
     *@brief Constructor
     *@param boardSize desk dimension
     */
     explicit Engine( const uint32_t boardSize );
 
+    /**
+     * @brief Stop the loop and the search, the reader of the output queue has stopped
+     *
+     * Unread output lines are dropped, a writer waiting for a free slot does not block the join.
+     */
     ~Engine();
 
+    /**
+     * @brief Queue the lines of a command for the loop, never waits for it
+     *
+     * Lines not fitting to the full queue are dropped and reported by an ERROR line.
+     * @param LastCommand one or more lines
+     */
     Engine& AddCommandsToInputQueue( const std::string& LastCommand );
 
     std::string ReadFromOutputQueue( int timeOutMs );
 
+    /**
+     * @brief Read an output line into a reused buffer, the previous buffer of line goes back to pipeOut()
+     * @param line next output line, empty on timeout
+     * @param timeOutMs how long to wait, 0ms is blocking wait
+     * @return false on timeout
+     */
+    bool ReadFromOutputQueue( std::string& line, int timeOutMs );
+
     bool IsEmptyOutputQueue();
 
     /**
@@ -67,34 +97,97 @@ public:
     [[nodiscard]] bool HasReaderInput() const { return !m_queueIn.is_empty(); }
 
     /**
-    *@brief Read last pipe output
+    *@brief Read last pipe output, the next call returns an empty string until pipeOut() writes again
     *@return last output string
     */
-    [[nodiscard]] std::string GetLastPipeOut() const { return std::move( m_LastPipeOut ); }
+    [[nodiscard]] std::string GetLastPipeOut() {
+        const auto lock = std::unique_lock<std::mutex>( m_pipeMutex );
+        auto       last = m_LastPipeOut;
+        m_LastPipeOut.clear();
+        return last;
+    }
+
+    /**
+     * @brief MESSAGE and DEBUG lines dropped by the full output queue, and any line after the destructor started
+     */
+    [[nodiscard]] uint64_t GetDroppedLines() const {
+        const auto lock = std::unique_lock<std::mutex>( m_pipeMutex );
+        return m_droppedLines;
+    }
+
+    /**
+     * @brief Test if a TURN search is running, commands except END and YXSTOP are refused
+     */
+    [[nodiscard]] bool IsInSearch() const { return m_bInSearch; }
+
+    /**
+     * @brief Test if the worker searches the expected reply, any command stops it
+     */
+    [[nodiscard]] bool IsPondering() const { return m_pondering; }
+
+    /**
+     * @brief Expected reply of the last ponder, valid while IsPondering()
+     */
+    [[nodiscard]] Move GetPonderMove() const { return m_ponderMove; }
 
     /**
      * @brief Main engine loop
      */
     bool Loop();
 
+    /**
+     * @brief Test if the engine loop is active, since StartLoop() until END
+     */
+    [[nodiscard]] bool IsLoopRunning() const { return m_loopIsRunning; }
+
     /**
      * @brief Send about info
      */
     void CmdAbout() const;
 
-    static eCommand ParseCmd( const std::string& s, std::string& rest );
+    /**
+     * @brief Command keyword of a line in any case, a perfect hash lookup without allocation
+     * @param s command line
+     * @param rest trimmed parameters, a view of s
+     * @return eUnknown if the first word is not a command
+     */
+    static eCommand ParseCmd( std::string_view s, std::string_view& rest );
 
     /**
      * @brief Returns Board representation
      */
     [[nodiscard]] Board* GetBoard() const { return m_board.get(); }
 
+    /**
+     * @brief Search cache, sized from INFO MAX_MEMORY
+     */
+    [[nodiscard]] const TranspositionTable& GetHashTable() const { return m_tt; }
+
+    /**
+     * @brief Bytes of the search, VCT and VCF caches
+     */
+    [[nodiscard]] uint64_t GetCacheSize() const { return m_tt.GetSize() + m_vct.GetSize() + m_vcf.GetSize(); }
+
+    /**
+     * @brief Bytes of INFO MAX_MEMORY kept out of the caches, the engine and a board and a search per thread
+     */
+    [[nodiscard]] uint64_t GetReservedMemory() const;
+
     /**
      * @brief Reference to info data
      */
     [[nodiscard]] Config& GetInfo() { return m_info; }
 
-    void CmdParseInfo( const std::string& params );
+    /**
+     * @brief INFO command, keywords in any case, FOLDER keeps the case of its path
+     * @param params command without INFO
+     */
+    void CmdParseInfo( std::string_view params );
+
+    /**
+     * @brief Opening book of INFO FOLDER, open if INFO USEDATABASE is set
+     */
+    [[nodiscard]] const OpeningBook& GetBook() const { return m_book; }
 
     /**
      * @brief One iteration action in a main engine loop
@@ -103,7 +196,7 @@ public:
      */
     [[nodiscard]] bool CmdExecute( const std::string& cmd );
 
-    void CmdParseStart( const std::string& params );
+    void CmdParseStart( std::string_view params );
 
     /**
      * @brief Start engine
@@ -115,34 +208,99 @@ public:
     std::string ReadInputLine();
     void StartLoop();
 private:
+    static constexpr uint32_t kFreeLines    = 32U;  /**< output buffers kept for reuse, power of 2 */
+    static constexpr size_t   kLineCapacity = 128U; /**< reserved bytes of a new output buffer */
+
+    /**
+    *@enum eInfoKey
+    *@brief Enumerated INFO keywords
+    */
+    enum class eInfoKey {
+        eTimeoutMatch,
+        eTimeoutTurn,
+        eTimeLeft,
+        eTimeIncrement,
+        eGameType,
+        eRule,
+        eFolder,
+        eMaxMemory,
+        eMaxDepth,
+        eMaxNode,
+        eThreadNum,
+        eUseDatabase,
+        ePonder,
+        ePowerSave,
+        eUnknown
+    };
 
     /**
     * @brief Parse info command data
-    * @param s string to parse
-    * @param rest data after command keyword
-    * @return info data
+    * @param s string to parse, keyword in any case
+    * @param rest trimmed data after the keyword, a view of s
+    * @return info keyword
     */
-    [[nodiscard]] static std::string ParseInfo( const std::string& s, std::string& rest );
+    [[nodiscard]] static eInfoKey ParseInfo( std::string_view s, std::string_view& rest );
+
+    /**
+     * @brief Queue a formatted line for the reader, called under m_pipeMutex
+     * @param data output line
+     * @param droppable MESSAGE or DEBUG line, dropped by the full queue instead of waiting for the reader
+     */
+    void WriteOutputLine( std::string&& data, bool droppable ) const;
 
-    void WriteOutputLine( const std::string& data ) const;
+    /**
+     * @brief INFO MAX_MEMORY without the reserved memory, each cache takes its share of it
+     */
+    [[nodiscard]] uint64_t GetCacheBudget() const;
+
+    /**
+     * @brief Split the cache budget again, after INFO MAX_MEMORY or THREAD_NUM
+     */
+    void ResizeCaches();
 
     void CmdResult() const;
 
     void StopLoop();
 
+    /**
+     * @brief Start the search on the worker, it leaves the search mode and answers the move
+     */
     void CmdTurn();
 
+    /**
+     * @brief Wait for the worker of the last TURN
+     * @param stop interrupt the search, the best move so far is answered
+     */
+    void WaitForSearch( bool stop );
+
+    /**
+     * @brief Board after the expected reply, INFO PONDER
+     * @return nullptr if there is no reply in the cache or the game is over
+     */
+    [[nodiscard]] std::unique_ptr<Board> PonderBoard();
+
+    /**
+     * @brief Search the expected reply until a command comes, results stay in the cache
+     * @param board position after the expected reply
+     */
+    void Ponder( Board& board );
+
+    /**
+     * @brief Stop and wait for the ponder search
+     */
+    void StopPonder();
+
     void CmdParseBoard( bool flipSides );
 
     void CmdShowForbid();
 
-    std::optional <std::vector<int64_t>> CmdParseCoords( const std::string& params );
+    std::optional<Util::Numbers> CmdParseCoords( std::string_view params );
 
-    void CmdParseTurn( const std::string& params );
+    void CmdParseTurn( std::string_view params );
 
-    void CmdParsePlay( const std::string& params );
+    void CmdParsePlay( std::string_view params );
 
-    void CmdParseTakeback( const std::string& params );
+    void CmdParseTakeback( std::string_view params );
 
     /**
     *@brief Remove move from board
@@ -171,20 +329,31 @@ private:
     [[nodiscard]] bool CmdPutMove( const coord_t x, const coord_t y );
 
     /**
-    *@brief Send response to command
+    *@brief Send response to command, waits for a free slot of the output queue
     *@param args data to output
     */
     template<typename... Args>
-    void pipeOut( Args&& ... args ) const {
-        std::stringstream ss;
+    void pipeOut( Args&& ... args ) const { pipeOutLine<false>( args... ); }
 
-        ( ss << ... << args );
+    /**
+    *@brief Format and queue an output line
+    *@tparam droppable the full output queue drops the line, see WriteOutputLine()
+    *@param args data to output
+    */
+    template<bool droppable, typename... Args>
+    void pipeOutLine( Args&& ... args ) const {
+        // the search worker writes too
+        const auto lock = std::unique_lock<std::mutex>( m_pipeMutex );
 
-        m_LastPipeOut = ss.str();
+        // a buffer returned by the reader, a new one only if the reader keeps them
+        auto line = m_queueFree.is_empty() ? std::string() : m_queueFree.pop( 1 );
+        line.clear();
+        Util::Append( line, args... );
+        m_LastPipeOut.assign( line );
 
-        __android_log_write( ANDROID_LOG_INFO, "PipeOut ", ss.str().c_str());
+        BRAIN_LOG( ANDROID_LOG_DEBUG, "PipeOut ", m_LastPipeOut );
 
-        WriteOutputLine( ss.str());
+        WriteOutputLine( std::move( line ), droppable );
     }
 
     /**
@@ -193,7 +362,7 @@ private:
     */
     template<typename... Args>
     void pipeOutDebug( Args&& ... args ) const {
-        pipeOut( "DEBUG ", args... );
+        pipeOutLine<true>( "DEBUG ", args... );
     }
 
     /**
@@ -201,21 +370,42 @@ private:
     *@param args data to output
     */
     template<typename... Args>
-    void pipeOutMessage( Args&& ... args ) const { pipeOut( "MESSAGE ", args... ); }
+    void pipeOutMessage( Args&& ... args ) const { pipeOutLine<true>( "MESSAGE ", args... ); }
 
     Config                           m_info;                     /**< configuration data */
     std::unique_ptr <Board>          m_board{
             nullptr }; /**< pointer to main board representation */
-    mutable LockedQueue<std::string> m_queueIn;        /**< input data  */
-    mutable LockedQueue<std::string> m_queueOut;       /**< output data  */
+    TranspositionTable               m_tt;                       /**< search cache */
+    Vcf                              m_vcf;                      /**< continuous fours solver */
+    Vct                              m_vct;                      /**< continuous threats solver */
+    OpeningBook                      m_book;                     /**< opening moves, see OpenBook() */
+    mutable SpscQueue<std::string, kInputLines> m_queueIn;       /**< input data, producers hold m_inputMutex */
+    mutable SpscQueue<std::string, kOutputLines> m_queueOut;     /**< output data, producers hold m_pipeMutex */
+    mutable SpscQueue<std::string, kFreeLines> m_queueFree;      /**< empty output buffers, back from the reader */
+    std::mutex                       m_inputMutex;               /**< JNI and StopLoop() can write at once */
     std::thread                      m_runner;
+    std::thread                      m_searcher;                 /**< search worker of the last TURN */
+    std::atomic_bool                 m_stopSearch    = false;    /**< YXSTOP or END, polled by the search */
     std::atomic_bool                 m_loopIsRunning = false;
+    std::atomic_bool                 m_closing       = false;    /**< destructor started, no line waits for the reader */
     uint32_t                         m_infoWidth;
     uint32_t                         m_infoHeight;
-    bool                             m_bInSearch     = false;
+    std::atomic_bool                 m_bInSearch     = false;
+    std::atomic_bool                 m_pondering     = false;    /**< the worker searches the expected reply */
+    Move                             m_ponderMove    = MOVE_NONE; /**< expected reply */
+    uint64_t                         m_ponderKey     = 0U;       /**< position of the last ponder, 0 if none */
+    uint32_t                         m_ponderDepth   = 0U;       /**< finished ponder iterations */
+    std::string                      m_formatLine;               /**< reused text of the VCT line or FORBID, the loop refuses YXSHOWFORBID during the search */
 
     Move CalculateMove();
-    mutable std::string              m_LastPipeOut;
+
+    /**
+     * @brief Map the book of INFO FOLDER if INFO USEDATABASE is set, close it otherwise
+     */
+    void OpenBook();
+    mutable std::string              m_LastPipeOut;              /**< last line of pipeOut(), const commands answer too */
+    mutable std::mutex               m_pipeMutex;                /**< guards m_LastPipeOut and the output order */
+    mutable uint64_t                 m_droppedLines  = 0U;       /**< lines of the full output queue, see WriteOutputLine() */
 };
 
 extern Engine* instance; /**< singleton ptr */
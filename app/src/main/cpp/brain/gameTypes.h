@@ -7,11 +7,18 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
 #include <cstdint>
+#include <ctime>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
-#include <android/log.h>
+#include "log.h"
 
 namespace Util {
     inline std::string Trim( const std::string& str ) {
@@ -27,39 +34,145 @@ namespace Util {
         return tmp;
     }
 
-    inline std::vector<int64_t>
-    ParseNumbers( const std::string& s, const std::string& delimiters ) {
-        auto res     = std::vector<int64_t>{};
-        auto numbers = std::vector<std::string>{}; // we'll put all of the tokens in here
-        const auto& numbers_str = s;
-
-        std::string token;
-
-        __android_log_write( ANDROID_LOG_VERBOSE, "parse num token", s.c_str());
-
-        size_t pos = 0;
+    /**
+     * @brief Trim without a copy
+     * @param str source string
+     * @return view of str without the leading and trailing white space
+     */
+    [[nodiscard]] constexpr std::string_view TrimView( std::string_view str ) {
+        constexpr std::string_view WhiteSpace = " \t\v\r\n";
 
-        for( size_t beg = 0;
-             ( beg = numbers_str.find_first_not_of( delimiters, pos )) != std::string::npos; ) {
-            pos = numbers_str.find_first_of( delimiters, beg + 1 );
-            numbers.push_back( numbers_str.substr( beg, pos - beg ));
+        const auto first = str.find_first_not_of( WhiteSpace );
+        if( first == std::string_view::npos ) {
+            return {};
         }
+        str.remove_prefix( first );
+        return str.substr( 0, str.find_last_not_of( WhiteSpace ) + 1 );
+    }
 
-        for( const auto& t : numbers ) {
-            auto       end   = static_cast<char*>( nullptr );
-            const auto value = strtoll( t.c_str(), &end, 10 );
-            if( end == t.c_str()) {
-                __android_log_write( ANDROID_LOG_INFO, "Error in parsing token ", t.c_str());
+    /**
+     * @brief Decimal numbers separated by any of the delimiters, strtoll() rules without allocation
+     *
+     * White space and a '+' before the digits are skipped, characters after them are ignored,
+     * out of range values saturate. The first token without a number ends the parsing.
+     * @param s text to parse
+     * @param delimiters token separators
+     * @param sink called with every number, returns false to stop
+     * @return count of numbers passed to sink
+     */
+    template<typename Sink>
+    size_t ForEachNumber( const std::string_view s, const std::string_view delimiters, Sink&& sink ) {
+        size_t count = 0U;
+        for( size_t beg = 0U, end = 0U; ( beg = s.find_first_not_of( delimiters, end )) != std::string_view::npos; ) {
+            end = s.find_first_of( delimiters, beg + 1 );
+            auto token = s.substr( beg, end - beg );
+
+            token.remove_prefix( std::min( token.find_first_not_of( " \t\v\f\r\n" ), token.size()));
+            const auto plus = !token.empty() && token.front() == '+';
+            if( plus ) {
+                token.remove_prefix( 1 );
+            }
+            int64_t    value = 0;
+            const auto res   = std::from_chars( token.data(), token.data() + token.size(), value );
+            if( res.ec == std::errc::invalid_argument || ( plus && token.front() == '-' )) {
+                BRAIN_LOG( ANDROID_LOG_INFO, "Error in parsing token ", token );
+                break;
+            }
+            if( res.ec == std::errc::result_out_of_range ) {
+                value = token.front() == '-' ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+            }
+            ++count;
+            if( !sink( value )) {
                 break;
             }
-            res.push_back( static_cast<int64_t>( value ));
-            __android_log_write( ANDROID_LOG_VERBOSE, "parse token ",
-                                 std::to_string( res.back()).c_str());
         }
+        return count;
+    }
 
+    /**
+     * @class Numbers
+     * @brief Numbers of one protocol line in a fixed buffer, the protocol needs 3 at most
+     */
+    class Numbers {
+    public:
+        static constexpr size_t kCapacity = 8U; /**< numbers kept, the following ones are dropped */
+
+        /**
+         * @brief Append a number
+         * @return false if the buffer is full
+         */
+        bool push_back( const int64_t value ) {
+            if( m_count == kCapacity ) {
+                return false;
+            }
+            m_values[m_count++] = value;
+            return true;
+        }
+
+        [[nodiscard]] size_t size() const { return m_count; }
+
+        [[nodiscard]] bool empty() const { return m_count == 0U; }
+
+        [[nodiscard]] int64_t operator[]( const size_t i ) const {
+            assert( i < m_count );
+            return m_values[i];
+        }
+
+        [[nodiscard]] const int64_t* begin() const { return m_values.data(); }
+
+        [[nodiscard]] const int64_t* end() const { return m_values.data() + m_count; }
+
+    private:
+        std::array<int64_t, kCapacity> m_values{}; /**< parsed numbers */
+        size_t                         m_count = 0U; /**< used values */
+    };
+
+    /**
+     * @brief Numbers of a protocol line, see ForEachNumber()
+     * @param s text to parse
+     * @param delimiters token separators
+     * @return up to Numbers::kCapacity numbers
+     */
+    [[nodiscard]] inline Numbers ParseNumbers( const std::string_view s, const std::string_view delimiters ) {
+        Numbers res;
+        ForEachNumber( s, delimiters, [&res]( const int64_t value ) { return res.push_back( value ); } );
         return res;
     }
 
+    /**
+     * @brief Append text, no allocation within the capacity of out
+     */
+    inline void AppendValue( std::string& out, const std::string_view text ) { out.append( text ); }
+
+    inline void AppendValue( std::string& out, const char* text ) { out.append( text ); }
+
+    inline void AppendValue( std::string& out, const std::string& text ) { out.append( text ); }
+
+    inline void AppendValue( std::string& out, const char c ) { out.push_back( c ); }
+
+    /**
+     * @brief Append integers and enums as decimal numbers like an ostream
+     */
+    template<typename T, typename = std::enable_if_t<( std::is_integral_v<T> && !std::is_same_v<T, bool> ) ||
+                                                     std::is_enum_v<T>>>
+    void AppendValue( std::string& out, const T value ) {
+        if constexpr( std::is_enum_v<T> ) {
+            AppendValue( out, static_cast<std::underlying_type_t<T>>( value ));
+        } else {
+            char       number[24];
+            const auto res = std::to_chars( number, number + sizeof( number ), value );
+            out.append( number, res.ptr );
+        }
+    }
+
+    /**
+     * @brief Append the values to a string, see AppendValue()
+     */
+    template<typename... Args>
+    void Append( std::string& out, const Args& ... args ) {
+        ( AppendValue( out, args ), ... );
+    }
+
     /**
      * @brief random number generator, srand() replacement
      * @return random value
@@ -119,6 +232,9 @@ constexpr uint32_t kMaxBoard     =
                            2 * kWallSize; /**< max board size is 24 for FreeStyle, 22 otherwise */
 constexpr uint32_t kPlaySize     = 20U;                      /**< default board size is 20 */
 constexpr uint64_t kTTMemorySize = 5ULL * 1024ULL * 1024ULL; /**< default cache size is 5MB */
+constexpr uint32_t kDefaultTimeoutTurn = 1000U; /**< move time if the manager sets no limit, ms */
+constexpr uint32_t kMoveOverheadMs     = 30U;   /**< reserve for the protocol round trip, ms */
+constexpr uint32_t kMaxThreads         = 64U;   /**< upper limit of INFO THREAD_NUM */
 
 static_assert( kWallSize == 4 || kWallSize == 5, "kWallSize" );
 static_assert( kBoardSize >= kMaxBoard + 2 * kWallSize, "No room for wall pieces" );
@@ -173,17 +289,38 @@ enum eMove_t {
     eBlock
 };
 
-/**  Move type, masks, constants */
+/**
+ * @enum eRule
+ * @brief Game rules, values of INFO RULE
+ */
+enum eRule : uint8_t {
+    eRuleFreestyle = 0U, /**< five or more stones win */
+    eRuleExactFive = 1U, /**< exactly five stones win */
+    eRuleRenju     = 4U  /**< exactly five for black, forbidden double three, double four and overline of black */
+};
+
+constexpr uint32_t kMoveCoordBits = 5U;                          /**< log2( kBoardSize ) */
+constexpr uint32_t kMoveCoordMask = ( 1U << kMoveCoordBits ) - 1U; /**< one coordinate */
+constexpr uint32_t kMoveTypeShift = 2U * kMoveCoordBits;           /**< eMove_t above the coordinates */
+constexpr uint32_t kMoveCoordsMask = ( 1U << kMoveTypeShift ) - 1U; /**< x * kBoardSize + y */
+
+static_assert( 1U << kMoveCoordBits == kBoardSize, "Packed coordinates are the desk index" );
+
+/**  Move type, packed to 16 bits: y in bits 0-4, x in bits 5-9, eMove_t in bits 10-11 */
 struct Move {
     constexpr Move() : Move( 0, 0, eMove_t::eEmpty ) {}
 
-    constexpr Move( coord_t x_, coord_t y_, eMove_t type_ ) : x( x_ ), y( y_ ), type( type_ ) {}
+    constexpr Move( coord_t x_, coord_t y_, eMove_t type_ ) :
+            data( static_cast<uint16_t>(( static_cast<uint32_t>( type_ ) << kMoveTypeShift ) |
+                                        (( x_ & kMoveCoordMask ) << kMoveCoordBits ) | ( y_ & kMoveCoordMask ))) {
+        assert( x_ < kBoardSize && y_ < kBoardSize );
+    }
 
-    coord_t x;
-    coord_t y;
-    eMove_t type;
+    uint16_t data; /**< packed coordinates and type */
 };
 
+static_assert( sizeof( Move ) == 2U, "Packed move" );
+
 constexpr Move MOVE_NONE = Move();
 
 /**@{
@@ -200,7 +337,7 @@ template<eMove_t player>
 /**
 *@brief Check if Move can be played on board
 */
-[[nodiscard]] inline constexpr bool IsOk( const Move m ) { return m.type != eMove_t::eEmpty; }
+[[nodiscard]] inline constexpr bool IsOk( const Move m ) { return ( m.data >> kMoveTypeShift ) != eMove_t::eEmpty; }
 
 static_assert( !IsOk( MOVE_NONE ));
 
@@ -208,7 +345,7 @@ static_assert( !IsOk( MOVE_NONE ));
 *@brief Check if Move is eMove_t::eEmpty
 */
 [[nodiscard]] inline constexpr bool IsEmpty( const Move m ) {
-    return m.type == eMove_t::eEmpty;
+    return ( m.data >> kMoveTypeShift ) == eMove_t::eEmpty;
 }
 
 static_assert( IsEmpty( MOVE_NONE ));
@@ -217,7 +354,7 @@ static_assert( IsEmpty( MOVE_NONE ));
 *@brief Check if Move is player type
 */
 template<eMove_t player>
-[[nodiscard]] inline constexpr bool IsType( Move m ) { return m.type == player; }
+[[nodiscard]] inline constexpr bool IsType( Move m ) { return ( m.data >> kMoveTypeShift ) == player; }
 
 /**
 *@brief Check if Move is eMove_t::eXX
@@ -233,26 +370,33 @@ template<eMove_t player>
 *@brief Get x-coordinate from Move
 */
 [[nodiscard]] inline constexpr coord_t GetX( Move m ) {
-    return static_cast<coord_t>(m.x);
+    return static_cast<coord_t>(( m.data >> kMoveCoordBits ) & kMoveCoordMask );
 }
 
 /**
 *@brief Get y-coordinate from Move
 */
 [[nodiscard]] inline constexpr coord_t GetY( Move m ) {
-    return static_cast<coord_t>(m.y);
+    return static_cast<coord_t>( m.data & kMoveCoordMask );
 }
 
 /**
 *@brief Get x,x-coordinates in form x * kBoardSize + y from Move
 */
-[[nodiscard]] inline constexpr coords_t GetCoords( Move m ) { return m.x * kBoardSize + m.y; }
+[[nodiscard]] inline constexpr coords_t GetCoords( Move m ) { return m.data & kMoveCoordsMask; }
 
 /**
 *@brief Get move type
 */
 [[nodiscard]] inline constexpr eMove_t GetType( Move m ) {
-    return m.type;
+    return static_cast<eMove_t>( m.data >> kMoveTypeShift );
+}
+
+/**
+*@brief Get the other player, eXX for eOO and vice versa
+*/
+[[nodiscard]] inline constexpr eMove_t GetOpponent( eMove_t player ) {
+    return player == eMove_t::eXX ? eMove_t::eOO : eMove_t::eXX;
 }
 
 /**
@@ -276,7 +420,7 @@ template<eMove_t player>
 *@brief Set move type, the rest is unchanged
 */
 [[nodiscard]] inline constexpr Move SetType( Move m, eMove_t type ) {
-    return Move( m.x, m.y, type );
+    return Move( GetX( m ), GetY( m ), type );
 }
 
 /**
@@ -285,7 +429,7 @@ template<eMove_t player>
 *@param other Move to compare
 */
 [[nodiscard]] inline constexpr bool HaveSameCoords( Move m, Move other ) {
-    return m.x == other.x && m.y == other.y;
+    return GetCoords( m ) == GetCoords( other );
 }
 
 /**
@@ -294,7 +438,7 @@ template<eMove_t player>
 *@param other Move to compare
 */
 [[nodiscard]] inline constexpr bool operator==( Move m, Move other ) {
-    return HaveSameCoords( m, other ) && m.type == other.type;
+    return m.data == other.data;
 }
 
 /** How much should be bit index shifted, log2(digit count) */
@@ -0,0 +1,106 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+/**
+ * @file keywords.h
+ * @brief Protocol keywords found by a compile-time perfect hash, a lookup does not allocate
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Keywords {
+    constexpr uint32_t kSlots = 32U; /**< hash table size, power of 2 */
+
+    /**
+     * @brief ASCII upper case, the protocol is ASCII only
+     */
+    [[nodiscard]] constexpr char ToUpper( const char c ) {
+        return c >= 'a' && c <= 'z' ? static_cast<char>( c - 'a' + 'A' ) : c;
+    }
+
+    /**
+     * @brief Slot of a word, the first and the last letter and the length in any case
+     */
+    [[nodiscard]] constexpr uint32_t Hash( const std::string_view word ) {
+        if( word.empty()) {
+            return 0U;
+        }
+        const auto first = static_cast<uint32_t>( static_cast<unsigned char>( ToUpper( word.front())));
+        const auto last  = static_cast<uint32_t>( static_cast<unsigned char>( ToUpper( word.back())));
+        return ( first * 31U + last + static_cast<uint32_t>( word.size())) & ( kSlots - 1U );
+    }
+
+    /**
+     * @brief Case insensitive comparison with an upper case keyword
+     */
+    [[nodiscard]] constexpr bool EqualsUpper( const std::string_view word, const std::string_view keyword ) {
+        if( word.size() != keyword.size()) {
+            return false;
+        }
+        for( size_t i = 0U; i < word.size(); ++i ) {
+            if( ToUpper( word[i] ) != keyword[i] ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @struct Keyword
+     * @brief Upper case keyword and its value
+     */
+    template<typename T>
+    struct Keyword {
+        std::string_view name;  /**< upper case keyword, empty for a free slot */
+        T                value; /**< value of the keyword */
+    };
+
+    /**
+     * @class Table
+     * @brief Keyword per hash slot, built by the compiler
+     *
+     * A lookup is one hash and one comparison, IsPerfect() must be checked by a static_assert.
+     * @tparam T keyword value, usually an enum
+     */
+    template<typename T>
+    class Table {
+    public:
+        /**
+         * @brief Constructor
+         * @param keywords upper case keywords
+         * @param none value of an unknown word
+         */
+        template<size_t N>
+        constexpr Table( const Keyword<T> ( &keywords )[N], const T none ) : m_none( none ) {
+            for( const auto& k : keywords ) {
+                auto& slot = m_slots[Hash( k.name )];
+                m_perfect  = m_perfect && slot.name.empty();
+                slot       = k;
+            }
+        }
+
+        /**
+         * @brief Keywords have different slots
+         */
+        [[nodiscard]] constexpr bool IsPerfect() const { return m_perfect; }
+
+        /**
+         * @brief Value of a word in any case
+         * @return none value of the constructor if the word is not a keyword
+         */
+        [[nodiscard]] constexpr T Find( const std::string_view word ) const {
+            const auto& slot = m_slots[Hash( word )];
+            return !slot.name.empty() && EqualsUpper( word, slot.name ) ? slot.value : m_none;
+        }
+
+    private:
+        std::array<Keyword<T>, kSlots> m_slots{}; /**< keyword of a hash slot */
+        T                              m_none;    /**< unknown word */
+        bool                           m_perfect = true; /**< no collision */
+    };
+}
+
+#endif // KEYWORDS_H
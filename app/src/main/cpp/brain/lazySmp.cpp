@@ -0,0 +1,51 @@
+/**
+ * @file lazySmp.cpp
+ * @brief Parallel search, helper threads share the transposition table
+ */
+
+#include "lazySmp.h"
+#include "board.h"
+#include "transpositionTable.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+LazySmp::LazySmp( Board& board, TranspositionTable& tt, const uint32_t threads ) :
+        m_board( board ), m_tt( tt ), m_threads( std::clamp( threads, 1U, kMaxThreads )), m_info() {}
+
+Move LazySmp::Think( const SearchLimits& limits, const Search::InfoCallback& onIteration ) {
+    SearchShared shared;
+    m_tt.NewSearch();
+
+    // copies are made before any thread changes the board
+    std::vector<std::unique_ptr<Board>> boards;
+    boards.reserve( m_threads - 1U );
+    for( auto i = 1U; i < m_threads; ++i ) {
+        boards.push_back( std::make_unique<Board>( m_board ));
+    }
+
+    auto helperLimits   = limits;
+    helperLimits.timeMs = 0U;
+    helperLimits.softMs = 0U;
+
+    std::vector<std::thread> helpers;
+    helpers.reserve( boards.size());
+    for( auto i = 1U; i < m_threads; ++i ) {
+        helpers.emplace_back( [this, &shared, &helperLimits, &boards, i]() {
+            Search search( *boards[i - 1U], m_tt, &shared, i );
+            static_cast<void>( search.Think( helperLimits ));
+        } );
+    }
+
+    Search     search( m_board, m_tt, &shared, 0U );
+    const auto best = search.Think( limits, onIteration );
+    shared.stop.store( true, std::memory_order_relaxed );
+    for( auto& helper : helpers ) {
+        helper.join();
+    }
+
+    m_info = search.GetInfo();
+    return best;
+}
@@ -0,0 +1,51 @@
+#ifndef LAZY_SMP_H
+#define LAZY_SMP_H
+
+/**
+ * @file lazySmp.h
+ * @brief Parallel search, helper threads share the transposition table
+ */
+
+#include "search.h"
+
+/**
+ * @class LazySmp
+ * @brief Main search on the board, helpers search private copies and fill the shared cache
+ */
+class LazySmp {
+public:
+    /**
+     * @brief Constructor
+     * @param board position to search, restored after the search
+     * @param tt search cache shared by all threads
+     * @param threads thread count including the main one
+     */
+    LazySmp( Board& board, TranspositionTable& tt, uint32_t threads );
+    ~LazySmp() = default;                          /**< destructor */
+    LazySmp() = delete;                            /**< hidden default constructor */
+    LazySmp( const LazySmp& ) = delete;            /**< hidden copy constructor */
+    LazySmp( LazySmp&& ) = delete;                 /**< hidden move copy constructor */
+    LazySmp& operator=( const LazySmp& ) = delete; /**< hidden assignment operator @return this */
+    LazySmp& operator=( LazySmp&& ) = delete;      /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Find the best move for the side to move, see Search::Think()
+     * @param limits stop conditions, the node limit counts nodes of all threads
+     * @param onIteration called by the main thread after every finished iteration, can be empty
+     * @return best move of the main thread
+     */
+    [[nodiscard]] Move Think( const SearchLimits& limits, const Search::InfoCallback& onIteration = nullptr );
+
+    /**
+     * @brief Data of the last finished iteration of the main thread
+     */
+    [[nodiscard]] const SearchInfo& GetInfo() const { return m_info; }
+
+private:
+    Board&              m_board;   /**< searched position */
+    TranspositionTable& m_tt;      /**< shared search cache */
+    uint32_t            m_threads; /**< thread count */
+    SearchInfo          m_info;    /**< main thread result */
+};
+
+#endif // LAZY_SMP_H
@@ -0,0 +1,114 @@
+/**
+ * @file log.cpp
+ * @brief Brain logging, the ring of the last messages
+ */
+
+#include "log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+std::atomic_int Log::gLevel{ Log::kCompileLevel };
+
+namespace {
+    constexpr uint32_t kRecords    = 64U;              /**< messages kept, power of 2 */
+    constexpr size_t   kWords      = 16U;              /**< record text in 64-bit words */
+    constexpr size_t   kRecordSize = kWords * 8U;      /**< record text with the terminating zero */
+    constexpr char     kPrioChar[] = "??VDIWEFS";      /**< logcat letter of a priority */
+
+    /**
+     * @struct Record
+     * @brief One message of the ring, a seqlock of atomic words
+     */
+    struct Record {
+        std::atomic<uint32_t> seq{ 0U };   /**< odd while written, 2 * index + 2 when message index is complete */
+        std::atomic<uint64_t> text[kWords]; /**< zero padded "P/tag: text" */
+    };
+
+    Record                gRing[kRecords];  /**< last messages */
+    std::atomic<uint32_t> gNext{ 0U };      /**< index of the next message */
+    std::atomic<uint32_t> gFirst{ 0U };     /**< oldest message of the dump, see ClearRing() */
+
+    /**
+     * @brief Store a message in the ring, concurrent writers get different records
+     */
+    void Store( const int prio, const char* tag, const std::string_view text ) {
+        Log::Line line;
+        line << kPrioChar[prio >= 0 && prio <= ANDROID_LOG_SILENT ? static_cast<size_t>( prio ) : 0U] << '/' << tag
+             << ": " << text;
+
+        char buffer[kRecordSize] = {};
+        std::memcpy( buffer, line.c_str(), std::min( line.View().size(), kRecordSize - 1U ));
+
+        const auto index  = gNext.fetch_add( 1U, std::memory_order_relaxed );
+        auto&      record = gRing[index & ( kRecords - 1U )];
+        record.seq.store( 2U * index + 1U, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        for( size_t i = 0U; i < kWords; ++i ) {
+            uint64_t word = 0U;
+            std::memcpy( &word, buffer + i * 8U, 8U );
+            record.text[i].store( word, std::memory_order_relaxed );
+        }
+        record.seq.store( 2U * index + 2U, std::memory_order_release );
+    }
+}
+
+void Log::SetLevel( const int prio ) {
+    gLevel.store( prio, std::memory_order_relaxed );
+}
+
+Log::Line& Log::Line::operator<<( const std::string_view text ) {
+    const auto length = std::min( text.size(), kLineSize - 1U - m_size );
+    std::memcpy( m_text + m_size, text.data(), length );
+    m_size += length;
+    m_text[m_size] = '\0';
+    return *this;
+}
+
+Log::Line& Log::Line::operator<<( const double value ) {
+    char       number[32];
+    const auto length = std::snprintf( number, sizeof( number ), "%g", value );
+    return *this << std::string_view( number, length > 0 ? static_cast<size_t>( length ) : 0U );
+}
+
+void Log::Emit( const int prio, const char* tag, const Line& line ) {
+    __android_log_write( prio, tag, line.c_str());
+    Store( prio, tag, line.View());
+}
+
+size_t Log::Dump( char* buffer, const size_t size ) {
+    const auto next  = gNext.load( std::memory_order_acquire );
+    const auto first = std::max( gFirst.load( std::memory_order_relaxed ), next > kRecords ? next - kRecords : 0U );
+
+    size_t written = 0U;
+    for( auto index = first; index != next; ++index ) {
+        const auto& record = gRing[index & ( kRecords - 1U )];
+        const auto  seq    = record.seq.load( std::memory_order_acquire );
+        if( seq != 2U * index + 2U ) {
+            continue;
+        }
+        char text[kRecordSize];
+        for( size_t i = 0U; i < kWords; ++i ) {
+            const auto word = record.text[i].load( std::memory_order_relaxed );
+            std::memcpy( text + i * 8U, &word, 8U );
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( record.seq.load( std::memory_order_relaxed ) != seq ) {
+            continue;
+        }
+
+        const auto length = strnlen( text, kRecordSize );
+        if( written + length + 1U > size ) {
+            break;
+        }
+        std::memcpy( buffer + written, text, length );
+        written += length;
+        buffer[written++] = '\n';
+    }
+    return written;
+}
+
+void Log::ClearRing() {
+    gFirst.store( gNext.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+}
@@ -0,0 +1,138 @@
+#ifndef LOG_H
+#define LOG_H
+
+/**
+ * @file log.h
+ * @brief Brain logging, compile-time and run-time priority filters and a ring of the last messages
+ *
+ * BRAIN_LOG( prio, tag, args... ) evaluates and formats its arguments only if the priority passes
+ * both filters. Calls below BRAIN_LOG_LEVEL are compiled away.
+ */
+
+#include <android/log.h>
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if !defined( BRAIN_LOG_LEVEL )
+#if defined( NDEBUG )
+#define BRAIN_LOG_LEVEL ANDROID_LOG_INFO
+#else
+#define BRAIN_LOG_LEVEL ANDROID_LOG_VERBOSE
+#endif
+#endif
+
+/**
+ * @brief Log a message built of the arguments, nothing is evaluated for a filtered priority
+ * @param prio android_LogPriority
+ * @param tag C string
+ * @param ... strings, characters and numbers, concatenated
+ */
+#define BRAIN_LOG( prio, tag, ... )                                                            \
+    do {                                                                                       \
+        if constexpr(( prio ) >= Log::kCompileLevel ) {                                        \
+            if( Log::IsEnabled( prio )) {                                                      \
+                Log::Write( prio, tag, __VA_ARGS__ );                                          \
+            }                                                                                  \
+        }                                                                                      \
+    } while( false )
+
+namespace Log {
+    constexpr int    kCompileLevel = BRAIN_LOG_LEVEL; /**< lowest priority compiled in */
+    constexpr size_t kLineSize     = 512U;            /**< longer messages are truncated */
+
+    extern std::atomic_int gLevel; /**< lowest priority written at run time */
+
+    /**
+     * @brief Lowest priority written, lower priorities are not even formatted
+     * @param prio android_LogPriority, ANDROID_LOG_SILENT disables the log
+     */
+    void SetLevel( int prio );
+
+    [[nodiscard]] inline int GetLevel() { return gLevel.load( std::memory_order_relaxed ); }
+
+    [[nodiscard]] inline bool IsEnabled( const int prio ) { return prio >= GetLevel(); }
+
+    /**
+     * @class Line
+     * @brief Message text in a fixed buffer, no allocation
+     */
+    class Line {
+    public:
+        Line() { m_text[0] = '\0'; } /**< empty text, the buffer is not cleared */
+
+        Line& operator<<( std::string_view text );
+
+        Line& operator<<( const char* text ) { return *this << std::string_view( text != nullptr ? text : "" ); }
+
+        Line& operator<<( const std::string& text ) { return *this << std::string_view( text ); }
+
+        Line& operator<<( char c ) { return *this << std::string_view( &c, 1U ); }
+
+        Line& operator<<( double value );
+
+        Line& operator<<( bool value ) { return *this << ( value ? "true" : "false" ); }
+
+        /**
+         * @brief Integers and enums as a decimal number
+         */
+        template<typename T, typename = std::enable_if_t<( std::is_integral_v<T> && !std::is_same_v<T, bool> ) ||
+                                                         std::is_enum_v<T>>>
+        Line& operator<<( const T value ) {
+            if constexpr( std::is_enum_v<T> ) {
+                return *this << static_cast<std::underlying_type_t<T>>( value );
+            } else {
+                const auto res = std::to_chars( m_text + m_size, m_text + kLineSize - 1U, value );
+                m_size = res.ec == std::errc() ? static_cast<size_t>( res.ptr - m_text ) : m_size;
+                m_text[m_size] = '\0';
+                return *this;
+            }
+        }
+
+        [[nodiscard]] const char* c_str() const { return m_text; }
+
+        [[nodiscard]] std::string_view View() const { return { m_text, m_size }; }
+
+    private:
+        char   m_text[kLineSize];  /**< zero terminated text */
+        size_t m_size = 0U;        /**< text length */
+    };
+
+    /**
+     * @brief Write a formatted message to the system log and to the ring
+     */
+    void Emit( int prio, const char* tag, const Line& line );
+
+    /**
+     * @brief Format and write a message, call BRAIN_LOG() to filter it first
+     */
+    template<typename... Args>
+    void Write( const int prio, const char* tag, const Args& ... args ) {
+        Line line;
+        ( line << ... << args );
+        Emit( prio, tag, line );
+    }
+
+    /**
+     * @brief Copy the last messages to a buffer, oldest first, one "P/tag: text" line each
+     *
+     * Lock-free and without allocation, it can be called from a crash handler.
+     * A message overwritten during the copy is skipped.
+     * @param buffer destination
+     * @param size buffer size
+     * @return bytes written, the text is not zero terminated
+     */
+    size_t Dump( char* buffer, size_t size );
+
+    /**
+     * @brief Forget the messages of the ring
+     */
+    void ClearRing();
+}
+
+#endif // LOG_H
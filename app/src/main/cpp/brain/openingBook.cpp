@@ -0,0 +1,143 @@
+/**
+ * @file openingBook.cpp
+ * @brief Binary opening book, memory mapped and indexed by a symmetry canonical key
+ */
+
+#include "openingBook.h"
+#include "board.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert( sizeof( OpeningBook::Header ) == 16U, "Header is a part of the file format" );
+static_assert( sizeof( OpeningBook::Entry ) == 16U, "Entry is a part of the file format" );
+
+OpeningBook::~OpeningBook() {
+    Close();
+}
+
+bool OpeningBook::Open( const std::string& path ) {
+    Close();
+
+    const auto fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd < 0 ) {
+        BRAIN_LOG( ANDROID_LOG_DEBUG, "Book", "no book file" );
+        return false;
+    }
+    struct stat st{};
+    const auto  length = fstat( fd, &st ) == 0 && st.st_size > 0 ? static_cast<size_t>( st.st_size ) : 0U;
+    auto* const map    = length >= sizeof( Header ) ? mmap( nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0 ) : MAP_FAILED;
+    close( fd );
+    if( map == MAP_FAILED ) {
+        BRAIN_LOG( ANDROID_LOG_ERROR, "Book", "book file cannot be mapped" );
+        return false;
+    }
+
+    // the entries follow the header, the map is page aligned
+    const auto* const header = static_cast<const Header*>( map );
+    if( header->magic != kMagic || header->version != kVersion || header->size == 0U || header->size > kPlaySize ||
+        length != sizeof( Header ) + static_cast<size_t>( header->count ) * sizeof( Entry )) {
+        munmap( map, length );
+        BRAIN_LOG( ANDROID_LOG_ERROR, "Book", "bad book file" );
+        return false;
+    }
+
+    m_map     = map;
+    m_length  = length;
+    m_entries = static_cast<const Entry*>( static_cast<const void*>( static_cast<const char*>( map ) + sizeof( Header )));
+    m_count   = header->count;
+    m_size    = header->size;
+    m_rule    = static_cast<eRule>( header->rule );
+    BRAIN_LOG( ANDROID_LOG_INFO, "Book", path );
+    return true;
+}
+
+void OpeningBook::Close() {
+    if( m_map != nullptr ) {
+        munmap( m_map, m_length );
+    }
+    m_map     = nullptr;
+    m_length  = 0U;
+    m_entries = nullptr;
+    m_count   = 0U;
+    m_size    = 0U;
+}
+
+OpeningBook::Entry OpeningBook::MakeEntry( const Board& board, coord_t x, coord_t y, const uint16_t weight ) {
+    uint32_t   symmetry = 0U;
+    const auto key      = board.GetCanonicalKey( board.GetBlack(), symmetry );
+    board.Transform( symmetry, x, y );
+    return Entry{ key, static_cast<uint8_t>( x ), static_cast<uint8_t>( y ), weight, 0U };
+}
+
+Move OpeningBook::Probe( const Board& board ) const {
+    if( !IsOpen() || board.GetDimX() != m_size || board.GetDimY() != m_size || board.GetRule() != m_rule ) {
+        return MOVE_NONE;
+    }
+    // the book knows black to move after an even count of stones only
+    const auto side = board.SideToMove() ? eMove_t::eXX : eMove_t::eOO;
+    if(( board.GetGamePly() % 2U == 0U ) != ( side == board.GetBlack())) {
+        return MOVE_NONE;
+    }
+
+    uint32_t   symmetry = 0U;
+    const auto key      = board.GetCanonicalKey( board.GetBlack(), symmetry );
+    const auto end      = m_entries + m_count;
+    auto       best     = std::lower_bound( m_entries, end, key, []( const Entry& e, const uint64_t k ) {
+        return e.key < k;
+    } );
+    if( best == end || best->key != key ) {
+        return MOVE_NONE;
+    }
+    for( auto it = best + 1; it != end && it->key == key; ++it ) {
+        if( it->weight > best->weight ) {
+            best = it;
+        }
+    }
+
+    coord_t x = best->x;
+    coord_t y = best->y;
+    if( x >= m_size || y >= m_size ) {
+        return MOVE_NONE;
+    }
+    board.InverseTransform( symmetry, x, y );
+    // a key collision must not play on a stone
+    if( board.GetDesk( x, y ) != eMove_t::eEmpty ) {
+        return MOVE_NONE;
+    }
+    return SetType( SetCoords( x, y ), side );
+}
+
+bool OpeningBook::Save( const std::string& path, const coord_t size, const eRule rule, std::vector<Entry> entries ) {
+    std::sort( entries.begin(), entries.end(), []( const Entry& a, const Entry& b ) {
+        return a.key != b.key ? a.key < b.key : a.x != b.x ? a.x < b.x : a.y < b.y;
+    } );
+
+    // one entry per move of a position, the weights are summed
+    std::vector<Entry> merged;
+    for( const auto& e : entries ) {
+        if( !merged.empty() && merged.back().key == e.key && merged.back().x == e.x && merged.back().y == e.y ) {
+            const auto weight = std::min<uint32_t>( uint32_t{ merged.back().weight } + e.weight, UINT16_MAX );
+            merged.back().weight = static_cast<uint16_t>( weight );
+        } else {
+            merged.push_back( Entry{ e.key, e.x, e.y, e.weight, 0U } );
+        }
+    }
+
+    const Header header{ kMagic, kVersion, static_cast<uint32_t>( merged.size()), static_cast<uint8_t>( size ),
+                         static_cast<uint8_t>( rule ), 0U };
+    auto* const file = std::fopen( path.c_str(), "wb" );
+    if( file == nullptr ) {
+        return false;
+    }
+    auto ok = std::fwrite( &header, sizeof( header ), 1U, file ) == 1U;
+    if( ok && !merged.empty()) {
+        ok = std::fwrite( merged.data(), sizeof( Entry ), merged.size(), file ) == merged.size();
+    }
+    return std::fclose( file ) == 0 && ok;
+}
@@ -0,0 +1,115 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+/**
+ * @file openingBook.h
+ * @brief Binary opening book, memory mapped and indexed by a symmetry canonical key
+ */
+
+#include "gameTypes.h"
+
+#include <string>
+#include <vector>
+
+class Board;
+
+/**
+ * @class OpeningBook
+ * @brief Read-only book of known positions and their moves
+ *
+ * The file is a Header followed by Entry records sorted by key. A key is Board::GetCanonicalKey()
+ * of the stones seen from black, book moves are stored in the orientation of that key.
+ */
+class OpeningBook {
+public:
+    static constexpr uint32_t kMagic    = 0x4B42474BU;   /**< "KGBK" in the file */
+    static constexpr uint32_t kVersion  = 2U;            /**< format version, 2 uses the symmetry keys of Board */
+    static constexpr auto     kFileName = "gomoku.book"; /**< book file in INFO FOLDER */
+
+    /**
+     * @struct Header
+     * @brief File header, the board and the rule the book was built for
+     */
+    struct Header {
+        uint32_t magic;   /**< kMagic */
+        uint32_t version; /**< kVersion */
+        uint32_t count;   /**< entries after the header */
+        uint8_t  size;    /**< square board size */
+        uint8_t  rule;    /**< eRule */
+        uint16_t unused;  /**< zero */
+    };
+
+    /**
+     * @struct Entry
+     * @brief One book move of one position
+     */
+    struct Entry {
+        uint64_t key;    /**< canonical key of the position */
+        uint8_t  x;      /**< move in the canonical orientation */
+        uint8_t  y;      /**< move in the canonical orientation */
+        uint16_t weight; /**< how often the move was played, the best is taken */
+        uint32_t unused; /**< zero */
+    };
+
+    OpeningBook() = default;                               /**< default constructor */
+    ~OpeningBook();                                        /**< destructor, unmaps the file */
+    OpeningBook( const OpeningBook& ) = delete;            /**< hidden copy constructor */
+    OpeningBook( OpeningBook&& ) = delete;                 /**< hidden move copy constructor */
+    OpeningBook& operator=( const OpeningBook& ) = delete; /**< hidden assignment operator @return this */
+    OpeningBook& operator=( OpeningBook&& ) = delete;      /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Map the book file, a previous book is closed
+     * @param path file name
+     * @return false if the file is missing or not a valid book
+     */
+    bool Open( const std::string& path );
+
+    /**
+     * @brief Unmap the book
+     */
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return m_entries != nullptr; }
+
+    /**
+     * @brief Entries of the book, zero if it is closed
+     */
+    [[nodiscard]] uint32_t GetCount() const { return m_count; }
+
+    /**
+     * @brief Book move of the position, binary search of the canonical key
+     * @param board position, the side to move must follow from the stone counts
+     * @return move typed as the side to move, MOVE_NONE if the position is not in the book
+     */
+    [[nodiscard]] Move Probe( const Board& board ) const;
+
+    /**
+     * @brief Book entry of the move in a position
+     * @param board position before the move, black is Board::GetBlack()
+     * @param x move
+     * @param y move
+     * @param weight how often the move was played
+     */
+    [[nodiscard]] static Entry MakeEntry( const Board& board, coord_t x, coord_t y, uint16_t weight );
+
+    /**
+     * @brief Write a book file, duplicated moves of a position are merged
+     * @param path file name
+     * @param size square board size
+     * @param rule rule of the games
+     * @param entries book moves in any order
+     * @return false if the file cannot be written
+     */
+    static bool Save( const std::string& path, coord_t size, eRule rule, std::vector<Entry> entries );
+
+private:
+    void*        m_map     = nullptr; /**< mapped file */
+    size_t       m_length  = 0U;      /**< mapped bytes */
+    const Entry* m_entries = nullptr; /**< sorted entries inside the map */
+    uint32_t     m_count   = 0U;      /**< entries */
+    coord_t      m_size    = 0U;      /**< board size of the book */
+    eRule        m_rule    = eRuleFreestyle; /**< rule of the book */
+};
+
+#endif // OPENING_BOOK_H
@@ -0,0 +1,10 @@
+/**
+ * @file pattern.cpp
+ * @brief Line shapes made by one stone, classification table
+ */
+
+#include "pattern.h"
+
+namespace Pattern {
+    constexpr CodeTable kCodeTable = GenerateCodeTable();
+}
@@ -0,0 +1,204 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+
+/**
+ * @file pattern.h
+ * @brief Line shapes made by one stone, classification and weights
+ */
+
+#include "gameTypes.h"
+
+#include <algorithm>
+#include <cassert>
+
+/**
+ * @enum ePattern
+ * @brief Shape created by a stone in one direction, ordered by strength
+ */
+enum ePattern : uint8_t {
+    ePatNone,
+    ePatBlock2,
+    ePatFlex2,
+    ePatBlock3,
+    ePatFlex3,
+    ePatBlock4,
+    ePatFlex4,
+    ePatFive,
+    ePatCount
+};
+
+/**
+ * @enum eLineCell
+ * @brief Cell content seen from one player
+ */
+enum eLineCell : uint8_t {
+    eLineEmpty,
+    eLineOwn,
+    eLineBlocked
+};
+
+constexpr uint32_t kLineHalf = 4U;                 /**< cells scanned on every side of the centre */
+constexpr uint32_t kLineSize = 2 * kLineHalf + 1U; /**< line length including the centre */
+constexpr uint32_t kDirCount = 4U;                 /**< horizontal, vertical and two diagonals */
+
+constexpr int kDirX[kDirCount] = { 1, 0, 1, 1 };  /**< x step of the directions */
+constexpr int kDirY[kDirCount] = { 0, 1, 1, -1 }; /**< y step of the directions */
+
+/** Move ordering and evaluation weights of the patterns */
+constexpr int32_t kPatternScore[ePatCount] = { 0, 2, 6, 6, 30, 35, 400, 5000 };
+
+using Line = eLineCell[kLineSize]; /**< cells around the centre, centre is kLineHalf */
+
+constexpr uint32_t kCodeDigits = 2U * kLineHalf; /**< neighbours of the centre in one direction */
+constexpr uint32_t kCodeCount  = 6561U;          /**< 3^kCodeDigits, eLineCell is one base 3 digit */
+
+/** Base 3 digit weights of the neighbours, offsets -4..-1 then +1..+4 */
+constexpr uint16_t kCodePow3[kCodeDigits] = { 1U, 3U, 9U, 27U, 81U, 243U, 729U, 2187U };
+
+namespace Pattern {
+    /**
+     * @brief Count cells completing five with the centre stone
+     * @param line cells, centre is own
+     * @param fives set to true if five is already there
+     * @return number of distinct empty cells making five
+     */
+    [[nodiscard]] constexpr uint32_t CountFourGaps( const Line& line, bool& fives ) {
+        bool gaps[kLineSize] = {};
+        fives = false;
+
+        for( uint32_t start = 0U; start <= kLineHalf; ++start ) {
+            auto own   = 0U;
+            auto empty = kLineSize;
+            auto clean = true;
+            for( auto i = start; i < start + 5U; ++i ) {
+                if( line[i] == eLineBlocked ) {
+                    clean = false;
+                    break;
+                }
+                if( line[i] == eLineOwn ) {
+                    ++own;
+                } else {
+                    empty = i;
+                }
+            }
+            if( clean && own == 5U ) {
+                fives = true;
+            } else if( clean && own == 4U ) {
+                gaps[empty] = true;
+            }
+        }
+
+        auto count = 0U;
+        for( const auto g : gaps ) {
+            count += g ? 1U : 0U;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Count windows of five cells through the centre without blocked cells
+     * @param line cells, centre is own
+     * @param minOwn minimal count of own stones in the window
+     * @return window count
+     */
+    [[nodiscard]] constexpr uint32_t CountWindows( const Line& line, const uint32_t minOwn ) {
+        auto count = 0U;
+        for( uint32_t start = 0U; start <= kLineHalf; ++start ) {
+            auto own   = 0U;
+            auto clean = true;
+            for( auto i = start; i < start + 5U; ++i ) {
+                clean = clean && line[i] != eLineBlocked;
+                own += line[i] == eLineOwn ? 1U : 0U;
+            }
+            count += clean && own >= minOwn ? 1U : 0U;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Classify shape of the centre stone, only 5-cell windows through the centre are used
+     * @param line cells, centre is own
+     * @return pattern
+     */
+    [[nodiscard]] constexpr ePattern ClassifyLine( const Line& line ) {
+        auto five  = false;
+        auto fours = CountFourGaps( line, five );
+        if( five ) {
+            return ePatFive;
+        }
+        if( fours > 0U ) {
+            return fours >= 2U ? ePatFlex4 : ePatBlock4;
+        }
+
+        // three if one more stone makes a four, open three if the four can be open
+        Line tmp      = {};
+        auto bestGaps = 0U;
+        for( uint32_t i = 0U; i < kLineSize; ++i ) {
+            tmp[i] = line[i];
+        }
+        for( uint32_t i = 0U; i < kLineSize; ++i ) {
+            if( tmp[i] == eLineEmpty ) {
+                tmp[i] = eLineOwn;
+                bestGaps = std::max( bestGaps, CountFourGaps( tmp, five ));
+                tmp[i] = eLineEmpty;
+            }
+        }
+        if( bestGaps > 0U ) {
+            return bestGaps >= 2U ? ePatFlex3 : ePatBlock3;
+        }
+
+        // two, open if there is enough room around
+        const auto twos = CountWindows( line, 2U );
+        if( twos >= 3U ) {
+            return ePatFlex2;
+        }
+        return twos > 0U ? ePatBlock2 : ePatNone;
+    }
+
+    /**
+     * @brief Digit of the neighbour in the line code
+     * @param offset distance from the centre, -kLineHalf..kLineHalf without 0
+     */
+    [[nodiscard]] constexpr uint32_t CodeDigit( const int offset ) {
+        return static_cast<uint32_t>( offset < 0 ? offset + static_cast<int>( kLineHalf )
+                                                 : offset + static_cast<int>( kLineHalf ) - 1 );
+    }
+
+    /**
+     * @struct CodeTable
+     * @brief Pattern of every line code
+     */
+    struct CodeTable {
+        ePattern pattern[kCodeCount]; /**< indexed by the line code */
+    };
+
+    /**
+     * @brief Classify all line codes, evaluated by the compiler once in pattern.cpp
+     */
+    [[nodiscard]] constexpr CodeTable GenerateCodeTable() {
+        CodeTable table = {};
+        for( uint32_t code = 0U; code < kCodeCount; ++code ) {
+            Line line = {};
+            line[kLineHalf] = eLineOwn;
+            auto rest = code;
+            for( uint32_t digit = 0U; digit < kCodeDigits; ++digit ) {
+                line[digit < kLineHalf ? digit : digit + 1U] = static_cast<eLineCell>( rest % 3U );
+                rest /= 3U;
+            }
+            table.pattern[code] = ClassifyLine( line );
+        }
+        return table;
+    }
+
+    extern const CodeTable kCodeTable; /**< line code classification */
+
+    /**
+     * @brief Pattern of the line code
+     */
+    [[nodiscard]] inline ePattern FromCode( const uint16_t code ) {
+        assert( code < kCodeCount );
+        return kCodeTable.pattern[code];
+    }
+}
+
+#endif // PATTERN_H
@@ -0,0 +1,98 @@
+#ifndef RENJU_H
+#define RENJU_H
+
+/**
+ * @file renju.h
+ * @brief Exact fives, fours and threes of one line, building blocks of the rule checks
+ */
+
+#include "pattern.h"
+
+namespace Renju {
+    constexpr uint32_t kHalf = kLineHalf + 1U; /**< one more cell than the patterns, an overline is visible */
+    constexpr uint32_t kSize = 2U * kHalf + 1U; /**< line length including the centre */
+
+    using Window = eLineCell[kSize]; /**< cells around the centre, centre is kHalf and own */
+
+    /**
+     * @brief Length of the own run through the cell, the cell counts as own
+     * @param w line
+     * @param i cell index
+     * @param lo set to the first cell of the run
+     * @param hi set to the last cell of the run
+     */
+    [[nodiscard]] constexpr uint32_t RunLength( const Window& w, const uint32_t i, uint32_t& lo, uint32_t& hi ) {
+        lo = i;
+        hi = i;
+        while( lo > 0U && w[lo - 1U] == eLineOwn ) {
+            --lo;
+        }
+        while( hi + 1U < kSize && w[hi + 1U] == eLineOwn ) {
+            ++hi;
+        }
+        return hi - lo + 1U;
+    }
+
+    /**
+     * @brief Length of the own run through the centre, runs over the window are seen as kHalf + 1
+     */
+    [[nodiscard]] constexpr uint32_t CentreRun( const Window& w ) {
+        uint32_t lo = 0U;
+        uint32_t hi = 0U;
+        return RunLength( w, kHalf, lo, hi );
+    }
+
+    /**
+     * @brief Count fours of the centre stone, empty cells making exactly five with it
+     * @param w line
+     * @param straight set if both cells belong to one open four
+     * @return fours, an open four counts once
+     */
+    [[nodiscard]] constexpr uint32_t CountFours( const Window& w, bool& straight ) {
+        uint32_t gaps[2] = {};
+        auto     count   = 0U;
+        for( auto i = 1U; i + 1U < kSize; ++i ) {
+            if( i == kHalf || w[i] != eLineEmpty ) {
+                continue;
+            }
+            uint32_t lo = 0U;
+            uint32_t hi = 0U;
+            if( RunLength( w, i, lo, hi ) == 5U && lo <= kHalf && kHalf <= hi ) {
+                if( count < 2U ) {
+                    gaps[count] = i;
+                }
+                ++count;
+            }
+        }
+        straight = count == 2U && gaps[1] - gaps[0] == 5U;
+        return straight ? 1U : count;
+    }
+
+    /**
+     * @brief Empty cells making an open four with the centre stone, the line is a three if there is one
+     * @param w line
+     * @param cells set to the cell indexes
+     * @return count of the cells
+     */
+    [[nodiscard]] constexpr uint32_t ThreeExtensions( const Window& w, uint32_t ( &cells )[kSize] ) {
+        auto   count = 0U;
+        Window tmp   = {};
+        for( auto i = 0U; i < kSize; ++i ) {
+            tmp[i] = w[i];
+        }
+        for( auto i = 1U; i + 1U < kSize; ++i ) {
+            if( i == kHalf || tmp[i] != eLineEmpty ) {
+                continue;
+            }
+            tmp[i]        = eLineOwn;
+            auto straight = false;
+            if( CountFours( tmp, straight ) == 1U && straight ) {
+                cells[count++] = i;
+            }
+            tmp[i] = eLineEmpty;
+        }
+        return count;
+    }
+}
+
+#endif // RENJU_H
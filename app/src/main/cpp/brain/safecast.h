@@ -7,6 +7,7 @@
 #ifndef SAFECAST_H
 #define SAFECAST_H
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -0,0 +1,399 @@
+/**
+ * @file search.cpp
+ * @brief Iterative deepening principal variation search
+ */
+
+#include "search.h"
+#include "board.h"
+#include "timeManager.h"
+#include "transpositionTable.h"
+
+namespace {
+    constexpr uint32_t kCheckPeriod = 1023U; /**< nodes between two limit checks, 2^n - 1 */
+
+    /**
+     * @brief Win scores are stored relative to the node
+     */
+    score_t ScoreToTT( const score_t score, const uint32_t ply ) {
+        if( score >= kScoreWinMin ) {
+            return score + static_cast<score_t>( ply );
+        }
+        if( score <= -kScoreWinMin ) {
+            return score - static_cast<score_t>( ply );
+        }
+        return score;
+    }
+
+    /**
+     * @brief Win scores are stored relative to the node
+     */
+    score_t ScoreFromTT( const score_t score, const uint32_t ply ) {
+        if( score >= kScoreWinMin ) {
+            return score - static_cast<score_t>( ply );
+        }
+        if( score <= -kScoreWinMin ) {
+            return score + static_cast<score_t>( ply );
+        }
+        return score;
+    }
+
+    /**
+     * @brief Sort moves by score, the best first, stable for equal scores
+     */
+    template<typename T>
+    void SortMoves( T* first, T* last ) {
+        std::stable_sort( first, last, []( const T& a, const T& b ) { return a.score > b.score; } );
+    }
+}
+
+Search::Search( Board& board, TranspositionTable& tt, SearchShared* shared, const uint32_t threadId ) :
+        m_board( board ), m_tt( tt ), m_shared( shared ), m_threadId( threadId ), m_limits(), m_info(),
+        m_start() {}
+
+uint64_t Search::ElapsedMs() const {
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_start ).count());
+}
+
+uint64_t Search::TotalNodes() const {
+    return m_shared ? m_shared->nodes.load( std::memory_order_relaxed ) + m_nodes - m_reported : m_nodes;
+}
+
+bool Search::CheckLimits() {
+    if( m_shared ) {
+        m_shared->nodes.fetch_add( m_nodes - m_reported, std::memory_order_relaxed );
+        m_reported = m_nodes;
+        if( m_shared->stop.load( std::memory_order_relaxed )) {
+            m_stop = true;
+        }
+    }
+    if(( m_limits.abort && m_limits.abort->load( std::memory_order_relaxed )) ||
+       ( m_limits.nodes > 0U && TotalNodes() >= m_limits.nodes ) ||
+       ( m_limits.timeMs > 0U && ElapsedMs() >= m_limits.timeMs )) {
+        m_stop = true;
+    }
+    return m_stop;
+}
+
+Search::NodeEval Search::Analyze( const uint32_t ply, const uint32_t maxMoves, NodeMoves& moves ) {
+    const auto me  = m_board.SideToMove() ? eMove_t::eXX : eMove_t::eOO;
+    const auto you = m_board.SideToMove() ? eMove_t::eOO : eMove_t::eXX;
+
+    auto&    all      = m_scratch;
+    auto     count    = 0U;
+    auto     myFive   = MOVE_NONE;
+    auto     myWin    = MOVE_NONE;
+    auto     yourFive = 0U;
+    auto     yourLock = false; // a five of the opponent on a cell forbidden to me
+    int64_t  mySum    = 0;
+    int64_t  yourSum  = 0;
+    Move     yourFives[2];
+
+    // overlines and fours made of them are not always wins
+    const auto myExact   = !m_board.IsOverlineWin( me );
+    const auto yourExact = !m_board.IsOverlineWin( you );
+
+    // candidate cells, empty and near to some stone
+    m_board.ForEachCandidate( [&]( const coord_t x, const coord_t y ) {
+        // the opponent can use a cell forbidden to me, only my move is skipped
+        const auto forbidden = m_board.IsForbidden( me, x, y );
+        const auto move      = SetType( SetCoords( x, y ), me );
+
+        int32_t myValue   = 0;
+        int32_t yourValue = 0;
+        auto    myFours   = 0U;
+        auto    yourFours = 0U;
+        for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+            const auto yours = m_board.GetPattern( you, x, y, dir );
+            yourValue += kPatternScore[yours];
+            if( yours == ePatFive && ( !yourExact || m_board.IsFive( you, x, y, dir ))) {
+                if( forbidden ) {
+                    yourLock = true;
+                } else if( yourFive < 2U ) {
+                    yourFives[yourFive++] = move;
+                }
+            }
+            yourFours += yours == ePatBlock4 ? 1U : 0U;
+            if( forbidden ) {
+                continue;
+            }
+
+            const auto mine = m_board.GetPattern( me, x, y, dir );
+            myValue += kPatternScore[mine];
+            if( mine == ePatFive && ( !myExact || m_board.IsFive( me, x, y, dir ))) {
+                myFive = move;
+            } else if( mine == ePatFlex4 && !myExact ) {
+                myWin = move;
+            }
+            myFours += mine == ePatBlock4 ? 1U : 0U;
+        }
+        yourSum += yourValue;
+        if( forbidden ) {
+            return;
+        }
+        if( myFours >= 2U && !myExact ) {
+            myWin = move;
+        }
+        mySum += myValue;
+        all[count++] = ScoredMove{ move, myValue + yourValue };
+    } );
+
+    moves.count = 0U;
+    const auto winScore = [ply]( uint32_t plies ) {
+        return kScoreWin - static_cast<score_t>( ply + plies );
+    };
+
+    if( IsOk( myFive )) {
+        moves.list[moves.count++] = ScoredMove{ myFive, kScoreWin };
+        return NodeEval{ winScore( 1U ), true, true };
+    }
+    if( yourFive > 0U ) {
+        for( auto i = 0U; i < yourFive; ++i ) {
+            moves.list[moves.count++] = ScoredMove{ yourFives[i], kScoreWin };
+        }
+    } else if( IsOk( myWin ) && !yourLock ) {
+        moves.list[moves.count++] = ScoredMove{ myWin, kScoreWin };
+        return NodeEval{ winScore( 3U ), true, true };
+    } else {
+        const auto keep = std::min( count, maxMoves );
+        std::partial_sort( all, all + keep, all + count,
+                           []( const ScoredMove& a, const ScoredMove& b ) { return a.score > b.score; } );
+        std::copy( all, all + keep, moves.list );
+        moves.count = keep;
+    }
+    if( yourFive >= 2U || yourLock ) {
+        // two fives, or a five on a cell forbidden to me, cannot be blocked
+        return NodeEval{ -winScore( 2U ), true, true };
+    }
+
+    const auto eval = std::clamp<int64_t>( mySum - yourSum, -kScoreEvalMax, kScoreEvalMax );
+    return NodeEval{ static_cast<score_t>( eval ), false, yourFive > 0U };
+}
+
+void Search::OrderCachedMove( NodeMoves& moves, const Move ttMove, const bool forced ) {
+    if( !IsOk( ttMove )) {
+        return;
+    }
+
+    auto idx = 0U;
+    while( idx < moves.count && !( moves.list[idx].move == ttMove )) {
+        ++idx;
+    }
+    if( idx == moves.count ) {
+        if( forced || moves.count == kMaxRootMoves ) {
+            return;
+        }
+        moves.list[moves.count++] = ScoredMove{ ttMove, 0 };
+    }
+    std::rotate( moves.list, moves.list + idx, moves.list + idx + 1U );
+}
+
+score_t Search::PVS( const int32_t depth, const uint32_t ply, score_t alpha, const score_t beta ) {
+    if(( ++m_nodes & kCheckPeriod ) == 0U ) {
+        CheckLimits();
+    } else if( m_limits.abort && m_limits.abort->load( std::memory_order_relaxed )) {
+        m_stop = true;
+    }
+    if( m_stop ) {
+        return 0;
+    }
+    if( m_board.IsLastMoveFive()) {
+        return -( kScoreWin - static_cast<score_t>( ply ));
+    }
+    if( m_board.IsFull()) {
+        return 0;
+    }
+
+    const auto key       = m_board.GetKey();
+    const auto alphaOrig = alpha;
+    auto       ttMove    = MOVE_NONE;
+    auto       tte       = TTEntry{};
+    if( m_tt.Probe( key, tte )) {
+        if( tte.hasMove ) {
+            ttMove = SetType( SetCoords( tte.x, tte.y ), m_board.SideToMove() ? eMove_t::eXX : eMove_t::eOO );
+            if( !m_board.CheckCoords( ttMove ) || !m_board.CanMakeMove( ttMove ) ||
+                m_board.IsForbidden( GetType( ttMove ), tte.x, tte.y )) {
+                ttMove = MOVE_NONE;
+            }
+        }
+        if( static_cast<int32_t>( tte.depth ) >= depth ) {
+            const auto score = ScoreFromTT( tte.score, ply );
+            if( tte.bound == eBoundExact ||
+                ( tte.bound == eBoundLower && score >= beta ) ||
+                ( tte.bound == eBoundUpper && score <= alpha )) {
+                return score;
+            }
+        }
+    }
+
+    NodeMoves  moves;
+    const auto eval = Analyze( ply, kMaxNodeMoves, moves );
+    if( eval.decided || depth <= 0 || ply + 1U >= kMaxSearchPly || moves.count == 0U ) {
+        return eval.score;
+    }
+    OrderCachedMove( moves, ttMove, eval.forced );
+
+    // forced replies do not consume depth
+    const auto newDepth = moves.count == 1U ? depth : depth - 1;
+    auto       best     = -kScoreInfinite;
+    auto       bestMove = MOVE_NONE;
+
+    for( auto i = 0U; i < moves.count; ++i ) {
+        const auto m = moves.list[i].move;
+        m_board.MakeMove( m );
+        auto score = 0;
+        if( i == 0U ) {
+            score = -PVS( newDepth, ply + 1U, -beta, -alpha );
+        } else {
+            score = -PVS( newDepth, ply + 1U, -alpha - 1, -alpha );
+            if( score > alpha && score < beta ) {
+                score = -PVS( newDepth, ply + 1U, -beta, -alpha );
+            }
+        }
+        m_board.UndoMove( m );
+
+        if( m_stop ) {
+            return 0;
+        }
+        if( score > best ) {
+            best     = score;
+            bestMove = m;
+            if( score > alpha ) {
+                alpha = score;
+                if( alpha >= beta ) {
+                    break;
+                }
+            }
+        }
+    }
+
+    auto entry    = TTEntry{};
+    entry.score   = static_cast<int16_t>( ScoreToTT( best, ply ));
+    entry.depth   = static_cast<uint8_t>( std::min( depth, 255 ));
+    entry.bound   = best >= beta ? eBoundLower : best > alphaOrig ? eBoundExact : eBoundUpper;
+    entry.hasMove = true;
+    entry.x       = GetX( bestMove );
+    entry.y       = GetY( bestMove );
+    m_tt.Store( key, entry );
+
+    return best;
+}
+
+Move Search::Think( const SearchLimits& limits, const InfoCallback& onIteration ) {
+    m_limits   = limits;
+    m_info     = SearchInfo{};
+    m_start    = std::chrono::steady_clock::now();
+    m_nodes    = 0U;
+    m_reported = 0U;
+    m_stop     = false;
+    if( !m_shared ) {
+        m_tt.NewSearch();
+    }
+
+    if( m_board.IsFull()) {
+        return MOVE_NONE;
+    }
+
+    const auto me = m_board.SideToMove() ? eMove_t::eXX : eMove_t::eOO;
+    if( m_board.GetGamePly() == 0U ) {
+        m_info.best = SetType( SetCoords( m_board.GetDimX() / 2U, m_board.GetDimY() / 2U ), me );
+        return m_info.best;
+    }
+
+    NodeMoves  root;
+    const auto eval = Analyze( 0U, kMaxRootMoves, root );
+    if( root.count == 0U ) {
+        // no empty cell close to stones
+        m_info.best = me == eMove_t::eXX ? m_board.GenerateRandomMove<eMove_t::eXX>()
+                                         : m_board.GenerateRandomMove<eMove_t::eOO>();
+        return m_info.best;
+    }
+    m_info.best  = root.list[0].move;
+    m_info.score = eval.score;
+    if( eval.decided || root.count == 1U ) {
+        return m_info.best;
+    }
+
+    auto tte = TTEntry{};
+    if( m_tt.Probe( m_board.GetKey(), tte ) && tte.hasMove ) {
+        const auto ttMove = SetType( SetCoords( tte.x, tte.y ), me );
+        if( m_board.CheckCoords( ttMove ) && m_board.CanMakeMove( ttMove ) &&
+            !m_board.IsForbidden( me, tte.x, tte.y )) {
+            OrderCachedMove( root, ttMove, eval.forced );
+        }
+    }
+
+    const auto maxDepth = limits.depth > 0U ? std::min( limits.depth, kMaxSearchPly - 1U )
+                                            : kMaxSearchPly - 1U;
+
+    const auto softMs       = limits.softMs > 0U ? limits.softMs : limits.timeMs / 2U;
+    auto       instability  = 0U;
+    auto       previousBest = m_info.best;
+
+    // helpers are one ply ahead every second thread, they fill the cache for the main thread
+    for( auto depth = 1U + m_threadId % 2U; depth <= maxDepth; ++depth ) {
+        auto alpha = -kScoreInfinite;
+        for( auto i = 0U; i < root.count; ++i ) {
+            const auto m = root.list[i].move;
+            m_board.MakeMove( m );
+            auto score = 0;
+            if( i == 0U ) {
+                score = -PVS( static_cast<int32_t>( depth ) - 1, 1U, -kScoreInfinite, -alpha );
+            } else {
+                score = -PVS( static_cast<int32_t>( depth ) - 1, 1U, -alpha - 1, -alpha );
+                if( score > alpha ) {
+                    score = -PVS( static_cast<int32_t>( depth ) - 1, 1U, -kScoreInfinite, -alpha );
+                }
+            }
+            m_board.UndoMove( m );
+
+            if( m_stop ) {
+                break;
+            }
+            root.list[i].score = score;
+            if( score > alpha ) {
+                alpha = score;
+                // the first move is the previous best, a better one is safe to play
+                m_info.best  = m;
+                m_info.score = score;
+            } else if( i > 0U ) {
+                root.list[i].score = -kScoreInfinite;
+            }
+        }
+
+        if( m_stop ) {
+            break;
+        }
+
+        SortMoves( root.list, root.list + root.count );
+
+        auto entry    = TTEntry{};
+        entry.score   = static_cast<int16_t>( m_info.score );
+        entry.depth   = static_cast<uint8_t>( depth );
+        entry.bound   = eBoundExact;
+        entry.hasMove = true;
+        entry.x       = GetX( m_info.best );
+        entry.y       = GetY( m_info.best );
+        m_tt.Store( m_board.GetKey(), entry );
+
+        m_info.depth  = depth;
+        m_info.nodes  = TotalNodes();
+        m_info.timeMs = ElapsedMs();
+        if( onIteration ) {
+            onIteration( m_info );
+        }
+
+        instability  = TimeManager::NextInstability( instability, !( m_info.best == previousBest ) );
+        previousBest = m_info.best;
+
+        // a forced win or loss is not improved by more iterations
+        if( mf::abs( m_info.score ) >= kScoreWinMin ||
+            ( limits.timeMs > 0U && m_info.timeMs >= TimeManager::ExtendSoft( softMs, limits.timeMs, instability )) ||
+            CheckLimits()) {
+            break;
+        }
+    }
+
+    m_info.nodes = TotalNodes();
+    return m_info.best;
+}
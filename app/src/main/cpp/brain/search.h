@@ -0,0 +1,184 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+/**
+ * @file search.h
+ * @brief Iterative deepening principal variation search
+ */
+
+#include "gameTypes.h"
+#include "pattern.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+class Board;
+
+class TranspositionTable;
+
+using score_t = int32_t; /**< search score type */
+
+constexpr uint32_t kMaxSearchPly  = 64U;    /**< max search ply, including extensions */
+constexpr uint32_t kMaxRootMoves  = 24U;    /**< best ordered moves searched at root */
+constexpr uint32_t kMaxNodeMoves  = 12U;    /**< best ordered moves searched in the tree */
+constexpr score_t  kScoreInfinite = 32000;  /**< bigger than any score */
+constexpr score_t  kScoreWin      = 30000;  /**< win at ply 0, decreased by ply */
+constexpr score_t  kScoreWinMin   = kScoreWin - static_cast<score_t>( kMaxSearchPly ); /**< lowest win */
+constexpr score_t  kScoreEvalMax  = 10000;  /**< static evaluation limit */
+
+/**
+ * @struct SearchLimits
+ * @brief Search stop conditions, zero means no limit
+ */
+struct SearchLimits {
+    uint32_t depth  = 0U; /**< max iteration depth in plies */
+    uint64_t nodes  = 0U; /**< max searched nodes */
+    uint32_t timeMs = 0U; /**< max time in milliseconds */
+    uint32_t softMs = 0U; /**< no new iteration after this time, extended for an unstable best move, timeMs / 2 if zero */
+
+    const std::atomic_bool* abort = nullptr; /**< external stop request polled in every node, can be nullptr */
+};
+
+/**
+ * @struct SearchInfo
+ * @brief Result of the last finished iteration
+ */
+struct SearchInfo {
+    uint32_t depth  = 0U;        /**< finished iteration */
+    score_t  score  = 0;         /**< score of the best move */
+    uint64_t nodes  = 0U;        /**< nodes searched so far */
+    uint64_t timeMs = 0U;        /**< elapsed time */
+    Move     best   = MOVE_NONE; /**< best move */
+};
+
+/**
+ * @struct SearchShared
+ * @brief State shared by the threads of one parallel search
+ */
+struct SearchShared {
+    std::atomic_bool      stop{ false }; /**< the main thread finished */
+    std::atomic<uint64_t> nodes{ 0U };   /**< nodes of all threads, updated in batches */
+};
+
+/**
+ * @class Search
+ * @brief Alpha-beta search with principal variation, works in place on a Board
+ */
+class Search {
+public:
+    using InfoCallback = std::function<void( const SearchInfo& )>; /**< iteration report */
+
+    /**
+     * @brief Constructor
+     * @param board position to search, restored after the search
+     * @param tt search cache, kept between searches
+     * @param shared stop flag and node count of a parallel search, nullptr for a single thread
+     * @param threadId 0 for the main thread, helpers start at different depths
+     */
+    Search( Board& board, TranspositionTable& tt, SearchShared* shared = nullptr, uint32_t threadId = 0U );
+    ~Search() = default;                          /**< destructor */
+    Search() = delete;                            /**< hidden default constructor */
+    Search( const Search& ) = delete;             /**< hidden copy constructor */
+    Search( Search&& ) = delete;                  /**< hidden move copy constructor */
+    Search& operator=( const Search& ) = delete;  /**< hidden assignment operator @return this */
+    Search& operator=( Search&& ) = delete;       /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Find the best move for the side to move
+     * @param limits stop conditions
+     * @param onIteration called after every finished iteration, can be empty
+     * @return best move, centre of the board if empty, MOVE_NONE if full
+     */
+    [[nodiscard]] Move Think( const SearchLimits& limits, const InfoCallback& onIteration = nullptr );
+
+    /**
+     * @brief Data of the last finished iteration
+     */
+    [[nodiscard]] const SearchInfo& GetInfo() const { return m_info; }
+
+private:
+    /**
+     * @struct ScoredMove
+     * @brief Move with ordering or search score
+     */
+    struct ScoredMove {
+        Move    move;  /**< move to play */
+        int32_t score; /**< ordering or search score */
+    };
+
+    /**
+     * @struct NodeMoves
+     * @brief Ordered moves of one node, only the best are kept
+     */
+    struct NodeMoves {
+        ScoredMove list[kMaxRootMoves]; /**< moves, best first */
+        uint32_t   count = 0U;          /**< valid moves */
+    };
+
+    /**
+     * @struct NodeEval
+     * @brief Static knowledge about the node
+     */
+    struct NodeEval {
+        score_t score;   /**< static score, side to move view */
+        bool    decided; /**< score is a proven win or loss */
+        bool    forced;  /**< only the generated moves are playable */
+    };
+
+    /**
+     * @brief Scan the candidate cells, evaluate the node and generate ordered moves
+     * @param ply distance from root
+     * @param maxMoves how many moves to keep
+     * @param moves generated moves
+     * @return static evaluation
+     */
+    NodeEval Analyze( uint32_t ply, uint32_t maxMoves, NodeMoves& moves );
+
+    /**
+     * @brief Principal variation search
+     * @param depth remaining depth
+     * @param ply distance from root
+     * @param alpha lower bound
+     * @param beta upper bound
+     * @return score, side to move view
+     */
+    score_t PVS( int32_t depth, uint32_t ply, score_t alpha, score_t beta );
+
+    /**
+     * @brief Move the cached best move to the front, insert it if it is missing
+     * @param moves ordered moves
+     * @param ttMove best move from the cache
+     * @param forced only the generated moves are playable
+     */
+    static void OrderCachedMove( NodeMoves& moves, Move ttMove, bool forced );
+
+    /**
+     * @brief Test node, time limits, sets the stop flag
+     */
+    bool CheckLimits();
+
+    /**
+     * @brief Elapsed time since Think() in milliseconds
+     */
+    [[nodiscard]] uint64_t ElapsedMs() const;
+
+    /**
+     * @brief Nodes of all threads
+     */
+    [[nodiscard]] uint64_t TotalNodes() const;
+
+    Board&                                m_board;                 /**< searched position */
+    TranspositionTable&                   m_tt;                    /**< search cache */
+    SearchShared*                         m_shared;                /**< parallel search state, can be nullptr */
+    uint32_t                              m_threadId;              /**< 0 for the main thread */
+    SearchLimits                          m_limits;                /**< stop conditions */
+    SearchInfo                            m_info;                  /**< finished iteration data */
+    std::chrono::steady_clock::time_point m_start;                 /**< search start time */
+    uint64_t                              m_nodes   = 0U;          /**< searched nodes */
+    uint64_t                              m_reported = 0U;         /**< nodes added to m_shared */
+    bool                                  m_stop    = false;       /**< stop request */
+    ScoredMove                            m_scratch[kBoardSize * kMaxBoard]; /**< all moves of a node */
+};
+
+#endif // SEARCH_H
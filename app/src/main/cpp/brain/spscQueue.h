@@ -0,0 +1,225 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+/**
+ * @file spscQueue.h
+ * @brief Bounded lock-free queue of one producer and one consumer
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#if defined( __linux__ )
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class SpscQueue
+ * @brief Ring buffer, push and pop are a few atomic operations, an empty pop and a full push can sleep on a futex
+ *
+ * One thread pushes and one thread pops at a time, other threads must be serialized by the caller.
+ * A full queue makes push() sleep until the consumer frees a slot, try_push() fails instead.
+ * @tparam T data type, moved in and out of the slots
+ * @tparam Capacity slots, power of 2, the 32-bit indexes wrap around
+ */
+template<typename T, uint32_t Capacity = 1024U>
+class SpscQueue final {
+    static_assert( Capacity >= 2U && ( Capacity & ( Capacity - 1U )) == 0U, "Capacity is a power of 2" );
+
+public:
+    SpscQueue() = default;                             /**< default constructor */
+    ~SpscQueue() = default;                            /**< destructor */
+    SpscQueue( const SpscQueue& ) = delete;            /**< hidden copy constructor */
+    SpscQueue( SpscQueue&& ) = delete;                 /**< hidden move copy constructor */
+    SpscQueue& operator=( const SpscQueue& ) = delete; /**< hidden assignment operator @return this */
+    SpscQueue& operator=( SpscQueue&& ) = delete;      /**< hidden move assignment operator @return this */
+
+    /**
+    *@brief Pops the first item, blocks if no data until timeout occurs
+    *@param timeout_ms how long to wait, 0ms is blocking wait
+    *@return the item, default value on timeout
+    */
+    T pop( int timeout_ms ) {
+        const auto head = m_head.load( std::memory_order_relaxed );
+        if( !WaitForData( head, timeout_ms )) {
+            return {};
+        }
+        T ret = std::move( m_slots[head & kMask] );
+
+        // free the slot, then wake a sleeping producer, a missed flag costs it one kPollMs, see WaitForSlot()
+        m_head.store( head + 1U, std::memory_order_release );
+        if( m_waitingSlot.load( std::memory_order_relaxed )) {
+            Wake( m_head );
+        }
+        return ret;
+    }
+
+    /**
+    *@brief Add item to the queue
+    *@param item data to store
+    */
+    void push( const T& item ) {
+        T copy( item );
+        push( std::move( copy ));
+    }
+
+    /**
+    *@brief Move item to the queue, blocks while the queue is full
+    *@param item data to store
+    */
+    void push( T&& item ) {
+        const auto tail = m_tail.load( std::memory_order_relaxed );
+        WaitForSlot( tail );
+        Publish( tail, std::move( item ));
+    }
+
+    /**
+    *@brief Move item to the queue if there is a free slot
+    *@param item data to store, left untouched if the queue is full
+    *@return false if the queue is full
+    */
+    [[nodiscard]] bool try_push( T&& item ) {
+        const auto tail = m_tail.load( std::memory_order_relaxed );
+        if( tail - m_head.load( std::memory_order_acquire ) == Capacity ) {
+            return false;
+        }
+        Publish( tail, std::move( item ));
+        return true;
+    }
+
+    /**
+    *@brief Return true if empty
+    */
+    [[nodiscard]] bool is_empty() const {
+        return m_tail.load( std::memory_order_acquire ) == m_head.load( std::memory_order_acquire );
+    }
+
+    /**
+    *@brief Returns count of items
+    */
+    [[nodiscard]] size_t count() const {
+        const auto head = m_head.load( std::memory_order_acquire );
+        return static_cast<size_t>( m_tail.load( std::memory_order_acquire ) - head );
+    }
+
+    /**
+    *@brief Clear the queue, called by the consumer
+    */
+    void clear() {
+        while( !is_empty()) {
+            pop( 1 );
+        }
+    }
+
+private:
+    static constexpr uint32_t kMask    = Capacity - 1U; /**< slot of an index */
+    static constexpr size_t kCacheLine = 64U;           /**< producer and consumer indexes do not share a line */
+    static constexpr int    kPollMs    = 1;             /**< sleep without futex, longest sleep of a full producer */
+
+    /**
+     * @brief Store the item to the free slot of tail and wake a sleeping consumer, see WaitForData()
+     */
+    void Publish( const uint32_t tail, T&& item ) {
+        m_slots[tail & kMask] = std::move( item );
+        m_tail.store( tail + 1U, std::memory_order_seq_cst );
+        if( m_sleeping.load( std::memory_order_seq_cst )) {
+            Wake( m_tail );
+        }
+    }
+
+    /**
+     * @brief Producer waits until the consumer frees the slot of tail
+     *
+     * The sleep is limited, pop() stays without a full fence and can miss the flag.
+     * @param tail producer index
+     */
+    void WaitForSlot( const uint32_t tail ) {
+        while( tail - m_head.load( std::memory_order_acquire ) == Capacity ) {
+            // the kernel compares the head before sleeping
+            m_waitingSlot.store( true, std::memory_order_seq_cst );
+            const auto head = m_head.load( std::memory_order_acquire );
+            if( tail - head == Capacity ) {
+                Sleep( m_head, head, std::chrono::milliseconds( kPollMs ));
+            }
+        }
+        m_waitingSlot.store( false, std::memory_order_relaxed );
+    }
+
+    /**
+     * @brief Consumer waits until the slot of head is published
+     * @param head consumer index
+     * @param timeout_ms 0 waits forever
+     * @return false on timeout
+     */
+    bool WaitForData( const uint32_t head, const int timeout_ms ) {
+        if( m_tail.load( std::memory_order_acquire ) != head ) {
+            return true;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeout_ms );
+        while( true ) {
+            // the producer reads the flag after publishing, the kernel compares the tail before sleeping
+            m_sleeping.store( true, std::memory_order_seq_cst );
+            if( m_tail.load( std::memory_order_seq_cst ) != head ) {
+                break;
+            }
+            auto remaining = std::chrono::milliseconds( 0 );
+            if( timeout_ms != 0 ) {
+                remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now());
+                if( remaining.count() <= 0 ) {
+                    m_sleeping.store( false, std::memory_order_relaxed );
+                    return false;
+                }
+            }
+            Sleep( m_tail, head, remaining );
+        }
+        m_sleeping.store( false, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_acquire );
+        return true;
+    }
+
+#if defined( __linux__ )
+    /**
+     * @brief Sleep while the index has the value, zero time sleeps until a wake up
+     */
+    static void Sleep( std::atomic<uint32_t>& index, const uint32_t value, const std::chrono::milliseconds time ) {
+        timespec timeout{ static_cast<time_t>( time.count() / 1000 ), static_cast<long>( time.count() % 1000 ) * 1000000L };
+        syscall( SYS_futex, reinterpret_cast<uint32_t*>( &index ), FUTEX_WAIT_PRIVATE, value,
+                 time.count() > 0 ? &timeout : nullptr, nullptr, 0 );
+    }
+
+    /**
+     * @brief Wake the other side sleeping on the index
+     */
+    static void Wake( std::atomic<uint32_t>& index ) {
+        syscall( SYS_futex, reinterpret_cast<uint32_t*>( &index ), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+    }
+#else
+    /**
+     * @brief Polling fallback without futex
+     */
+    static void Sleep( std::atomic<uint32_t>&, uint32_t, const std::chrono::milliseconds time ) {
+        std::this_thread::sleep_for( std::min( time.count() > 0 ? time : std::chrono::milliseconds( kPollMs ),
+                                               std::chrono::milliseconds( kPollMs )));
+    }
+
+    static void Wake( std::atomic<uint32_t>& ) {}
+#endif
+
+    static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "futex word is the atomic itself" );
+
+    alignas( kCacheLine ) std::atomic<uint32_t> m_head{ 0U };           /**< next slot to pop, futex word of the producer */
+    std::atomic_bool                            m_waitingSlot{ false }; /**< the producer may sleep on m_head */
+    alignas( kCacheLine ) std::atomic<uint32_t> m_tail{ 0U };           /**< next slot to push, futex word of the consumer */
+    std::atomic_bool                            m_sleeping{ false };    /**< the consumer may sleep on m_tail */
+    alignas( kCacheLine ) T                     m_slots[Capacity]; /**< ring of items */
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,61 @@
+/**
+ * @file timeManager.cpp
+ * @brief Thinking time of one turn from the Gomocup time control
+ */
+
+#include "timeManager.h"
+#include "config.h"
+
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Time without the protocol reserve, half of the time if it is too short
+     */
+    constexpr uint32_t WithoutReserve( const uint32_t timeMs ) {
+        return timeMs > 2U * kMoveOverheadMs ? timeMs - kMoveOverheadMs : timeMs / 2U;
+    }
+}
+
+TimeManager::TimeManager( const Config& info, const size_t gamePly ) : m_start( std::chrono::steady_clock::now()) {
+    if( info.GetTimeoutTurn() == 0U && info.IsTimeoutTurnSet()) {
+        // as fast as possible, the first iteration ends the turn
+        m_hardMs = kMoveOverheadMs;
+        m_softMs = 1U;
+    } else {
+        const auto turn = info.GetTimeoutTurn() > 0U ? info.GetTimeoutTurn() : kDefaultTimeoutTurn;
+        m_hardMs = WithoutReserve( turn );
+        m_softMs = m_hardMs / 2U;
+    }
+
+    if( info.GetTimeoutMatch() > 0U ) {
+        // TIME_LEFT comes before every turn, the whole match time is used until it is known
+        const auto left      = info.GetTimeLeft() > 0U ? info.GetTimeLeft() : info.GetTimeoutMatch();
+        const auto usable    = WithoutReserve( left );
+        const auto ownMoves  = static_cast<uint32_t>( gamePly / 2U );
+        const auto movesToGo = std::max( kMinMovesToGo, kExpectedMoves > ownMoves ? kExpectedMoves - ownMoves : 0U );
+        const auto increment = info.GetTimeInc() / 2U;
+
+        m_hardMs = std::min( m_hardMs, usable / kHardShare + increment );
+        m_softMs = std::min( m_softMs, usable / movesToGo + increment );
+    }
+
+    // zero means no limit in the search
+    m_hardMs = std::max( m_hardMs, 1U );
+    m_softMs = std::clamp( m_softMs, 1U, m_hardMs );
+}
+
+uint32_t TimeManager::ElapsedMs() const {
+    return static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_start ).count());
+}
+
+uint32_t TimeManager::RemainingSoftMs() const {
+    const auto elapsed = ElapsedMs();
+    return m_softMs > elapsed ? m_softMs - elapsed : 1U;
+}
+
+uint32_t TimeManager::RemainingHardMs() const {
+    const auto elapsed = ElapsedMs();
+    return m_hardMs > elapsed ? m_hardMs - elapsed : 1U;
+}
@@ -0,0 +1,99 @@
+#ifndef TIME_MANAGER_H
+#define TIME_MANAGER_H
+
+/**
+ * @file timeManager.h
+ * @brief Thinking time of one turn from the Gomocup time control
+ */
+
+#include "gameTypes.h"
+
+#include <chrono>
+
+class Config;
+
+/**
+ * @class TimeManager
+ * @brief Soft and hard deadline of one turn, counted from the construction
+ *
+ * The hard deadline is never crossed, the soft one is checked between iterations
+ * and grows while the best move keeps changing.
+ */
+class TimeManager {
+public:
+    static constexpr uint32_t kExpectedMoves  = 60U; /**< own moves of a long game */
+    static constexpr uint32_t kMinMovesToGo   = 12U; /**< match time is never split into fewer parts */
+    static constexpr uint32_t kHardShare      = 5U;  /**< one turn takes at most 1/kHardShare of the match time */
+    static constexpr uint32_t kUnstableScale  = 4U;  /**< instability units of 100% extension */
+    static constexpr uint32_t kUnstableStep   = 4U;  /**< instability added by a new best move */
+    static constexpr uint32_t kUnstableMax    = 12U; /**< soft limit grows up to 4x */
+
+    /**
+     * @brief Constructor, the turn starts now
+     * @param info TIMEOUT_TURN, TIMEOUT_MATCH, TIME_LEFT and TIME_INCREMENT, zero values are unknown,
+     *             a set TIMEOUT_TURN 0 asks for the fastest answer
+     * @param gamePly stones on the board
+     */
+    TimeManager( const Config& info, size_t gamePly );
+    ~TimeManager() = default;                              /**< destructor */
+    TimeManager() = delete;                                /**< hidden default constructor */
+    TimeManager( const TimeManager& ) = delete;            /**< hidden copy constructor */
+    TimeManager( TimeManager&& ) = delete;                 /**< hidden move copy constructor */
+    TimeManager& operator=( const TimeManager& ) = delete; /**< hidden assignment operator @return this */
+    TimeManager& operator=( TimeManager&& ) = delete;      /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Planned time of the turn, a new iteration is not started after it
+     */
+    [[nodiscard]] uint32_t GetSoftMs() const { return m_softMs; }
+
+    /**
+     * @brief Time limit of the turn without the protocol reserve
+     */
+    [[nodiscard]] uint32_t GetHardMs() const { return m_hardMs; }
+
+    /**
+     * @brief Time since the construction
+     */
+    [[nodiscard]] uint32_t ElapsedMs() const;
+
+    /**
+     * @brief Remaining soft time, at least 1 ms
+     */
+    [[nodiscard]] uint32_t RemainingSoftMs() const;
+
+    /**
+     * @brief Remaining hard time, at least 1 ms
+     */
+    [[nodiscard]] uint32_t RemainingHardMs() const;
+
+    /**
+     * @brief Soft limit extended for an unstable best move
+     * @param softMs planned time
+     * @param hardMs time limit
+     * @param instability 0 for a stable best move, kUnstableScale doubles the soft limit
+     * @return extended soft limit, never above the hard one
+     */
+    [[nodiscard]] static constexpr uint64_t ExtendSoft( const uint64_t softMs, const uint64_t hardMs,
+                                                        const uint32_t instability ) {
+        const auto extended = softMs * ( kUnstableScale + instability ) / kUnstableScale;
+        return extended < hardMs ? extended : hardMs;
+    }
+
+    /**
+     * @brief Instability after an iteration, old changes fade out
+     * @param instability value after the previous iteration
+     * @param bestChanged the iteration found a new best move
+     */
+    [[nodiscard]] static constexpr uint32_t NextInstability( const uint32_t instability, const bool bestChanged ) {
+        const auto next = instability / 2U + ( bestChanged ? kUnstableStep : 0U );
+        return next < kUnstableMax ? next : kUnstableMax;
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;      /**< turn start */
+    uint32_t                              m_softMs = 0U; /**< planned time */
+    uint32_t                              m_hardMs = 0U; /**< time limit */
+};
+
+#endif // TIME_MANAGER_H
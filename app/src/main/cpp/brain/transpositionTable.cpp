@@ -0,0 +1,126 @@
+/**
+ * @file transpositionTable.cpp
+ * @brief Search cache, buckets of entries aligned to cache lines, shared by search threads
+ */
+
+#include "transpositionTable.h"
+#include "log.h"
+
+#include <new>
+
+namespace {
+    constexpr int32_t kAgeWeight = 8; /**< one search of age is worth this depth */
+    constexpr auto    kRelaxed   = std::memory_order_relaxed; /**< slots are validated by the key check */
+}
+
+TranspositionTable::TranspositionTable( const uint64_t maxMemory ) {
+    Resize( maxMemory );
+}
+
+void TranspositionTable::Resize( const uint64_t maxMemory ) {
+    const auto budget = maxMemory / kMemoryShare;
+
+    auto count = uint64_t{ 1U };
+    while( count * 2U * kBucketSize <= budget ) {
+        count *= 2U;
+    }
+
+    if( count != m_bucketCount ) {
+        m_table.reset();
+        m_table.reset( new( std::nothrow ) Bucket[count] );
+        m_bucketCount = m_table ? count : 0U;
+        if( !m_table ) {
+            BRAIN_LOG( ANDROID_LOG_ERROR, "TT", "allocation failed" );
+            m_table.reset( new Bucket[1] );
+            m_bucketCount = 1U;
+        }
+    }
+    Clear();
+}
+
+void TranspositionTable::Clear() {
+    for( uint64_t i = 0U; i < m_bucketCount; ++i ) {
+        for( auto& slot : m_table[i].slot ) {
+            slot.check.store( 0U, kRelaxed );
+            slot.data.store( 0U, kRelaxed );
+        }
+    }
+    m_generation = 0U;
+}
+
+uint64_t TranspositionTable::Pack( const TTEntry& entry, const uint8_t generation ) {
+    return static_cast<uint64_t>( static_cast<uint16_t>( entry.score )) |
+           ( static_cast<uint64_t>( entry.depth ) << 16U ) |
+           ( static_cast<uint64_t>( entry.bound ) << 24U ) |
+           ( static_cast<uint64_t>( generation & kGenerationMask ) << 26U ) |
+           ( static_cast<uint64_t>( entry.hasMove ? 1U : 0U ) << 32U ) |
+           ( static_cast<uint64_t>( entry.x & 0x1FU ) << 33U ) |
+           ( static_cast<uint64_t>( entry.y & 0x1FU ) << 38U );
+}
+
+TTEntry TranspositionTable::Unpack( const uint64_t data ) {
+    auto entry    = TTEntry{};
+    entry.score   = static_cast<int16_t>( static_cast<uint16_t>( data & 0xFFFFU ));
+    entry.depth   = static_cast<uint8_t>(( data >> 16U ) & 0xFFU );
+    entry.bound   = static_cast<eBound>(( data >> 24U ) & 0x3U );
+    entry.hasMove = (( data >> 32U ) & 1U ) != 0U;
+    entry.x       = static_cast<coord_t>(( data >> 33U ) & 0x1FU );
+    entry.y       = static_cast<coord_t>(( data >> 38U ) & 0x1FU );
+    return entry;
+}
+
+bool TranspositionTable::Probe( const uint64_t key, TTEntry& entry ) {
+    for( auto& slot : GetBucket( key ).slot ) {
+        const auto data = slot.data.load( kRelaxed );
+        if( data != 0U && ( slot.check.load( kRelaxed ) ^ data ) == key ) {
+            entry = Unpack( data );
+            if( entry.bound != eBoundNone ) {
+                // refresh the age once per search, a hot entry stays a shared cache line of all threads
+                if( Generation( data ) != m_generation ) {
+                    const auto fresh = Pack( entry, m_generation );
+                    slot.check.store( key ^ fresh, kRelaxed );
+                    slot.data.store( fresh, kRelaxed );
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::Store( const uint64_t key, const TTEntry& entry ) {
+    auto& bucket  = GetBucket( key );
+    auto  victim  = &bucket.slot[0];
+    auto  oldData = victim->data.load( kRelaxed );
+    auto  same    = false;
+    auto  worst   = std::numeric_limits<int32_t>::max();
+
+    for( auto& slot : bucket.slot ) {
+        const auto data = slot.data.load( kRelaxed );
+        same = data != 0U && ( slot.check.load( kRelaxed ) ^ data ) == key;
+        if( same || data == 0U ) {
+            victim  = &slot;
+            oldData = data;
+            break;
+        }
+        const auto age   = static_cast<int32_t>(( m_generation - Generation( data )) & kGenerationMask );
+        const auto value = static_cast<int32_t>( Unpack( data ).depth ) - kAgeWeight * age;
+        if( value < worst ) {
+            worst   = value;
+            victim  = &slot;
+            oldData = data;
+        }
+    }
+
+    auto data = entry;
+    if( !data.hasMove && same ) {
+        // keep the known best move of the position
+        const auto old = Unpack( oldData );
+        data.hasMove = old.hasMove;
+        data.x       = old.x;
+        data.y       = old.y;
+    }
+    const auto packed = Pack( data, m_generation );
+    victim->check.store( key ^ packed, kRelaxed );
+    victim->data.store( packed, kRelaxed );
+}
@@ -0,0 +1,138 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+/**
+ * @file transpositionTable.h
+ * @brief Search cache, buckets of entries aligned to cache lines, shared by search threads
+ */
+
+#include "gameTypes.h"
+
+#include <atomic>
+#include <memory>
+
+/**
+ * @enum eBound
+ * @brief Meaning of the stored score
+ */
+enum eBound : uint8_t {
+    eBoundNone,
+    eBoundUpper,
+    eBoundLower,
+    eBoundExact
+};
+
+/**
+ * @struct TTEntry
+ * @brief Unpacked cache entry
+ */
+struct TTEntry {
+    int16_t  score = 0;           /**< search score, mate scores relative to the node */
+    uint8_t  depth = 0U;          /**< search depth */
+    eBound   bound = eBoundNone;  /**< score type */
+    bool     hasMove = false;     /**< x, y are valid */
+    coord_t  x = 0U;              /**< best move coordinate */
+    coord_t  y = 0U;              /**< best move coordinate */
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Cache of search results keyed by Board::GetKey()
+ *
+ * Lock-free, a slot keeps key ^ data, a torn write of two threads does not match any key.
+ */
+class TranspositionTable {
+public:
+    static constexpr uint32_t kBucketEntries = 4U;  /**< entries in one cache line */
+    static constexpr uint64_t kBucketSize    = 64U; /**< bucket size in bytes */
+    static constexpr uint32_t kMemoryShare   = 2U;  /**< the table takes 1/kMemoryShare of MAX_MEMORY */
+
+    /**
+     * @brief Constructor
+     * @param maxMemory memory budget of the brain, see Resize()
+     */
+    explicit TranspositionTable( uint64_t maxMemory );
+    ~TranspositionTable() = default;                                    /**< destructor */
+    TranspositionTable() = delete;                                      /**< hidden default constructor */
+    TranspositionTable( const TranspositionTable& ) = delete;           /**< hidden copy constructor */
+    TranspositionTable( TranspositionTable&& ) = delete;                /**< hidden move copy constructor */
+    TranspositionTable& operator=( const TranspositionTable& ) = delete; /**< hidden assignment operator @return this */
+    TranspositionTable& operator=( TranspositionTable&& ) = delete;     /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Reallocate and clear the table, the biggest power of 2 buckets within the budget
+     * @param maxMemory memory budget of the brain in bytes, the table takes a fixed share
+     */
+    void Resize( uint64_t maxMemory );
+
+    /**
+     * @brief Erase all entries
+     */
+    void Clear();
+
+    /**
+     * @brief Start new search, older entries are preferred for replacement, call before threads start
+     */
+    void NewSearch() { m_generation = static_cast<uint8_t>(( m_generation + 1U ) & kGenerationMask ); }
+
+    /**
+     * @brief Find the position
+     * @param key position key
+     * @param entry found data
+     * @return true if found
+     */
+    [[nodiscard]] bool Probe( uint64_t key, TTEntry& entry );
+
+    /**
+     * @brief Store search result, replaces the same position or the least valuable entry
+     * @param key position key
+     * @param entry data to store
+     */
+    void Store( uint64_t key, const TTEntry& entry );
+
+    /**
+     * @brief Table size in bytes
+     */
+    [[nodiscard]] uint64_t GetSize() const { return m_bucketCount * kBucketSize; }
+
+private:
+    static constexpr uint32_t kGenerationMask = 0x3FU; /**< 6 bits of age */
+
+    /**
+     * @struct Slot
+     * @brief Packed entry, key and data
+     */
+    struct Slot {
+        std::atomic<uint64_t> check; /**< position key ^ data */
+        std::atomic<uint64_t> data;  /**< packed TTEntry and generation */
+    };
+
+    /**
+     * @struct Bucket
+     * @brief Slots sharing one cache line
+     */
+    struct alignas( kBucketSize ) Bucket {
+        Slot slot[kBucketEntries]; /**< entries */
+    };
+
+    static_assert( sizeof( Bucket ) == kBucketSize, "Bucket must fill a cache line" );
+
+    /**
+     * @brief Bucket for the key
+     */
+    [[nodiscard]] Bucket& GetBucket( uint64_t key ) { return m_table[key & ( m_bucketCount - 1U )]; }
+
+    [[nodiscard]] static uint64_t Pack( const TTEntry& entry, uint8_t generation );
+
+    [[nodiscard]] static TTEntry Unpack( uint64_t data );
+
+    [[nodiscard]] static uint8_t Generation( uint64_t data ) {
+        return static_cast<uint8_t>(( data >> 26U ) & kGenerationMask );
+    }
+
+    std::unique_ptr<Bucket[]> m_table;              /**< buckets */
+    uint64_t                  m_bucketCount = 0U;   /**< power of 2 */
+    uint8_t                   m_generation  = 0U;   /**< current search age */
+};
+
+#endif // TRANSPOSITION_TABLE_H
@@ -0,0 +1,189 @@
+/**
+ * @file vcf.cpp
+ * @brief Victory by continuous fours, threat space search with its own cache
+ */
+
+#include "vcf.h"
+#include "board.h"
+
+Vcf::Vcf( const uint64_t maxMemory ) {
+    Resize( maxMemory );
+}
+
+void Vcf::Resize( const uint64_t maxMemory ) {
+    const auto budget = maxMemory / kMemoryShare;
+
+    auto count = uint64_t{ 1U };
+    while( count < kCacheSize && count * 2U * sizeof( Entry ) <= budget ) {
+        count *= 2U;
+    }
+
+    if( count != m_entryCount ) {
+        m_cache      = std::make_unique<Entry[]>( count );
+        m_entryCount = count;
+    }
+    Clear();
+}
+
+void Vcf::Clear() {
+    for( uint64_t i = 0U; i < m_entryCount; ++i ) {
+        m_cache[i] = Entry{};
+    }
+}
+
+uint32_t Vcf::FiveCells( const Board& board, const eMove_t player, const coord_t x, const coord_t y,
+                         Move( &cells )[2] ) {
+    auto count = 0U;
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        for( auto k = -static_cast<int>( kLineHalf ); k <= static_cast<int>( kLineHalf ); ++k ) {
+            const auto nx = static_cast<int>( x ) + k * kDirX[dir];
+            const auto ny = static_cast<int>( y ) + k * kDirY[dir];
+            if( k == 0 || board.GetDeskOrWall( nx, ny ) != eMove_t::eEmpty ) {
+                continue;
+            }
+            const auto cell = SetType( SetCoords( static_cast<coord_t>( nx ), static_cast<coord_t>( ny )), player );
+            if( board.IsFive( player, GetX( cell ), GetY( cell ), dir ) &&
+                !( count > 0U && cells[0] == cell )) {
+                if( count < 2U ) {
+                    cells[count] = cell;
+                }
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+uint32_t Vcf::FiveCells( const Board& board, const eMove_t player, Move( &cells )[2] ) {
+    auto count = 0U;
+    const auto exact = !board.IsOverlineWin( player );
+    board.ForEachThreat( player, eThreatFive, [&]( const coord_t x, const coord_t y ) {
+        if( exact && !board.IsFive( player, x, y )) {
+            return;
+        }
+        if( count < 2U ) {
+            cells[count] = SetType( SetCoords( x, y ), player );
+        }
+        ++count;
+    } );
+    return count;
+}
+
+Move Vcf::Solve( Board& board, const uint64_t maxNodes, const std::atomic_bool* abort ) {
+    m_nodes    = 0U;
+    m_maxNodes = maxNodes;
+    m_abort    = abort;
+    m_aborted  = false;
+
+    const auto me  = board.SideToMove() ? eMove_t::eXX : eMove_t::eOO;
+    Move       cells[2];
+    if( FiveCells( board, me, cells ) > 0U ) {
+        return SetType( cells[0], me );
+    }
+
+    const auto threats = FiveCells( board, GetOpponent( me ), cells );
+    if( threats >= 2U ) {
+        return MOVE_NONE;
+    }
+
+    auto first = MOVE_NONE;
+    if( Attack( board, kMaxDepth, threats == 1U ? cells[0] : MOVE_NONE, first )) {
+        return first;
+    }
+    return MOVE_NONE;
+}
+
+bool Vcf::Attack( Board& board, const uint32_t depth, const Move mustBlock, Move& first ) {
+    if(( m_maxNodes > 0U && m_nodes >= m_maxNodes ) ||
+       ( m_abort && m_abort->load( std::memory_order_relaxed ))) {
+        m_aborted = true;
+        return false;
+    }
+    ++m_nodes;
+
+    const auto key   = board.GetKey();
+    auto&      entry = GetEntry( key );
+    const auto me    = board.SideToMove() ? eMove_t::eXX : eMove_t::eOO;
+    const auto you   = GetOpponent( me );
+    if( entry.key == key ) {
+        if( entry.win ) {
+            first = SetType( SetCoords( entry.x, entry.y ), me );
+            return true;
+        }
+        if( entry.depth >= depth ) {
+            return false;
+        }
+    }
+    if( depth == 0U ) {
+        return false;
+    }
+
+    // four making moves, open fours first
+    Move fours[kMaxFours];
+    auto count     = 0U;
+    auto openFours = 0U;
+    const auto addFour = [&]( const coord_t x, const coord_t y ) {
+        if( board.IsForbidden( me, x, y )) {
+            return;
+        }
+        auto four = false;
+        auto open = false;
+        for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+            const auto pat = board.GetPattern( me, x, y, dir );
+            four = four || pat == ePatBlock4 || pat == ePatFlex4;
+            open = open || pat == ePatFlex4;
+        }
+        if( four && count < kMaxFours ) {
+            fours[count] = SetType( SetCoords( x, y ), me );
+            if( open ) {
+                std::swap( fours[count], fours[openFours++] );
+            }
+            ++count;
+        }
+    };
+
+    if( IsOk( mustBlock )) {
+        addFour( GetX( mustBlock ), GetY( mustBlock ));
+    } else {
+        board.ForEachThreat( me, eThreatFour, addFour );
+    }
+
+    for( auto i = 0U; i < count; ++i ) {
+        const auto attack = fours[i];
+        board.MakeMove( attack );
+
+        Move fives[2];
+        auto win = false;
+        const auto n = FiveCells( board, me, GetX( attack ), GetY( attack ), fives );
+        if( n >= 2U ) {
+            win = true;
+        } else if( n == 1U ) {
+            // the only defence, it can create a five threat of the defender or be forbidden
+            const auto defence = SetType( fives[0], you );
+            if( board.IsForbidden( you, GetX( defence ), GetY( defence ))) {
+                win = true;
+            } else {
+                board.MakeMove( defence );
+                Move       threats[2];
+                const auto t = FiveCells( board, you, GetX( defence ), GetY( defence ), threats );
+                auto       next = MOVE_NONE;
+                win = t < 2U && Attack( board, depth - 1U, t == 1U ? threats[0] : MOVE_NONE, next );
+                board.UndoMove( defence );
+            }
+        }
+        board.UndoMove( attack );
+
+        if( win ) {
+            first = attack;
+            entry = Entry{ key, static_cast<uint8_t>( depth ), true, static_cast<uint8_t>( GetX( attack )),
+                           static_cast<uint8_t>( GetY( attack )) };
+            return true;
+        }
+        if( m_aborted ) {
+            return false;
+        }
+    }
+
+    entry = Entry{ key, static_cast<uint8_t>( depth ), false, 0U, 0U };
+    return false;
+}
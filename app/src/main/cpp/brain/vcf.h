@@ -0,0 +1,120 @@
+#ifndef VCF_H
+#define VCF_H
+
+/**
+ * @file vcf.h
+ * @brief Victory by continuous fours, threat space search with its own cache
+ */
+
+#include "gameTypes.h"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+
+class Board;
+
+/**
+ * @class Vcf
+ * @brief Prove a win by a sequence of fours, the defender has only forced replies
+ */
+class Vcf {
+public:
+    static constexpr uint32_t kMaxDepth    = 40U;          /**< max attacker fours in one line */
+    static constexpr uint32_t kCacheSize   = 1U << 16U;    /**< most cache entries, power of 2 */
+    static constexpr uint32_t kMemoryShare = 8U;           /**< the cache takes 1/kMemoryShare of MAX_MEMORY */
+    static constexpr uint64_t kRootNodes   = 10000U;       /**< node budget before the main search */
+    static constexpr uint32_t kMaxFours    = 64U;          /**< four moves tried in one node */
+
+    /**
+     * @brief Constructor
+     * @param maxMemory memory budget of the brain, see Resize(), the biggest cache by default
+     */
+    explicit Vcf( uint64_t maxMemory = std::numeric_limits<uint64_t>::max());
+    ~Vcf() = default;                      /**< destructor */
+    Vcf( const Vcf& ) = delete;            /**< hidden copy constructor */
+    Vcf( Vcf&& ) = delete;                 /**< hidden move copy constructor */
+    Vcf& operator=( const Vcf& ) = delete; /**< hidden assignment operator @return this */
+    Vcf& operator=( Vcf&& ) = delete;      /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Reallocate and clear the cache, the biggest power of 2 entries within the budget
+     * @param maxMemory memory budget of the brain in bytes, the cache takes a fixed share up to kCacheSize entries
+     */
+    void Resize( uint64_t maxMemory );
+
+    /**
+     * @brief Forget all proven and disproven positions
+     */
+    void Clear();
+
+    /**
+     * @brief Search a win for the side to move
+     * @param board position, restored after the search
+     * @param maxNodes node limit, zero means no limit
+     * @param abort external stop request polled in every node, can be nullptr
+     * @return first move of the win, MOVE_NONE if no win was found
+     */
+    [[nodiscard]] Move Solve( Board& board, uint64_t maxNodes, const std::atomic_bool* abort = nullptr );
+
+    /**
+     * @brief Nodes visited by the last Solve()
+     */
+    [[nodiscard]] uint64_t GetNodes() const { return m_nodes; }
+
+    /**
+     * @brief Cache size in bytes
+     */
+    [[nodiscard]] uint64_t GetSize() const { return m_entryCount * sizeof( Entry ); }
+
+    /**
+     * @brief Cells where the player makes five, on the four lines through x,y
+     * @param board position
+     * @param player eXX or eOO
+     * @param x line centre
+     * @param y line centre
+     * @param cells found cells typed as the player, at most two are kept
+     * @return count of distinct cells
+     */
+    [[nodiscard]] static uint32_t FiveCells( const Board& board, eMove_t player, coord_t x, coord_t y,
+                                             Move( &cells )[2] );
+
+    /**
+     * @brief Cells where the player makes five, whole board
+     */
+    [[nodiscard]] static uint32_t FiveCells( const Board& board, eMove_t player, Move( &cells )[2] );
+
+private:
+    /**
+     * @struct Entry
+     * @brief Cached result, proven win or no win within the depth
+     */
+    struct Entry {
+        uint64_t key;   /**< position key, attacker to move */
+        uint8_t  depth; /**< remaining depth of the disproof */
+        bool     win;   /**< proven win */
+        uint8_t  x;     /**< winning move coordinate */
+        uint8_t  y;     /**< winning move coordinate */
+    };
+
+    /**
+     * @brief Attacker to move, prove a win
+     * @param board position
+     * @param depth remaining attacker moves
+     * @param mustBlock defender five cell, attacker has to play there, MOVE_NONE if none
+     * @param first set to the winning move of this node
+     * @return proven win
+     */
+    bool Attack( Board& board, uint32_t depth, Move mustBlock, Move& first );
+
+    [[nodiscard]] Entry& GetEntry( uint64_t key ) { return m_cache[key & ( m_entryCount - 1U )]; }
+
+    std::unique_ptr<Entry[]> m_cache;            /**< proven and disproven positions */
+    uint64_t                 m_entryCount = 0U;   /**< cache entries, power of 2 */
+    uint64_t                 m_nodes     = 0U;   /**< visited nodes */
+    uint64_t                 m_maxNodes  = 0U;   /**< node limit */
+    const std::atomic_bool*  m_abort     = nullptr; /**< external stop request */
+    bool                     m_aborted   = false; /**< node limit reached, disproofs are not valid */
+};
+
+#endif // VCF_H
@@ -0,0 +1,310 @@
+/**
+ * @file vct.cpp
+ * @brief Victory by continuous threats, depth-first proof-number search
+ */
+
+#include "vct.h"
+#include "board.h"
+#include "vcf.h"
+#include "log.h"
+
+#include <new>
+
+namespace {
+    constexpr uint64_t kSaltStep = 0x9E3779B97F4A7C15ULL; /**< new salt for every search */
+
+    /**
+     * @brief Saturated sum of proof numbers
+     */
+    constexpr uint32_t AddPn( const uint32_t a, const uint32_t b ) {
+        return std::min( a + b, Vct::kInfinite );
+    }
+}
+
+Vct::Vct( const uint64_t maxMemory ) : m_start() {
+    Resize( maxMemory );
+}
+
+void Vct::Resize( const uint64_t maxMemory ) {
+    const auto budget = maxMemory / kMemoryShare;
+
+    auto count = uint64_t{ 1U };
+    while( count * 2U * sizeof( Entry ) <= budget ) {
+        count *= 2U;
+    }
+
+    if( count != m_entryCount ) {
+        m_table.reset();
+        m_table.reset( new( std::nothrow ) Entry[count] );
+        m_entryCount = m_table ? count : 0U;
+        if( !m_table ) {
+            BRAIN_LOG( ANDROID_LOG_ERROR, "VCT", "allocation failed" );
+            m_table.reset( new Entry[1] );
+            m_entryCount = 1U;
+        }
+    }
+    for( uint64_t i = 0U; i < m_entryCount; ++i ) {
+        m_table[i] = Entry{};
+    }
+}
+
+void Vct::CheckLimits() {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_start ).count();
+    if(( m_abort && m_abort->load( std::memory_order_relaxed )) ||
+       ( m_maxNodes > 0U && m_nodes >= m_maxNodes ) ||
+       ( m_timeMs > 0U && elapsed >= static_cast<int64_t>( m_timeMs ))) {
+        m_stop = true;
+    }
+}
+
+void Vct::Lookup( const uint64_t key, uint32_t& pn, uint32_t& dn ) const {
+    const auto& entry = GetEntry( key ^ m_salt );
+    if( entry.key == ( key ^ m_salt )) {
+        pn = entry.pn;
+        dn = entry.dn;
+    } else {
+        pn = 1U;
+        dn = 1U;
+    }
+}
+
+void Vct::Store( const uint64_t key, const uint32_t pn, const uint32_t dn ) {
+    GetEntry( key ^ m_salt ) = Entry{ key ^ m_salt, pn, dn };
+}
+
+bool Vct::AddMove( NodeMoves& moves, const Move m ) {
+    for( auto i = 0U; i < moves.count; ++i ) {
+        if( moves.list[i] == m ) {
+            return true;
+        }
+    }
+    if( moves.count == kMaxMoves ) {
+        return false;
+    }
+    moves.list[moves.count++] = m;
+    return true;
+}
+
+Vct::eNodeResult Vct::Generate( Board& board, const uint32_t ply, NodeMoves& moves ) const {
+    moves.count = 0U;
+    const auto attacker = m_attacker;
+    const auto defender = GetOpponent( attacker );
+    const auto last     = board.GetLastMove();
+    Move       cells[2];
+
+    if( ply % 2U == 0U ) {
+        // attacker to move, only fours and open threes, a defender five threat must be blocked
+        if( ply == 0U && Vcf::FiveCells( board, attacker, cells ) > 0U ) {
+            moves.list[moves.count++] = SetType( cells[0], attacker );
+            return eNodeResult::eProven;
+        }
+        const auto threats = ply == 0U ? Vcf::FiveCells( board, defender, cells )
+                                       : Vcf::FiveCells( board, defender, GetX( last ), GetY( last ), cells );
+        if( threats >= 2U || ply >= kMaxPly ) {
+            return eNodeResult::eDisproven;
+        }
+
+        auto fours = 0U;
+        auto five  = false;
+        const auto addThreat = [&]( const coord_t x, const coord_t y ) {
+            if( five || board.IsForbidden( attacker, x, y )) {
+                return;
+            }
+            auto best = ePatNone;
+            for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+                best = std::max( best, board.GetPattern( attacker, x, y, dir ));
+            }
+            if( best == ePatFive && board.IsFive( attacker, x, y )) {
+                moves.list[0] = SetType( SetCoords( x, y ), attacker );
+                moves.count   = 1U;
+                five          = true;
+            } else if( best >= ePatFlex3 && best != ePatFive && moves.count < kMaxMoves ) {
+                moves.list[moves.count] = SetType( SetCoords( x, y ), attacker );
+                if( best >= ePatBlock4 ) {
+                    std::swap( moves.list[moves.count], moves.list[fours++] );
+                }
+                ++moves.count;
+            }
+        };
+
+        if( threats == 1U ) {
+            addThreat( GetX( cells[0] ), GetY( cells[0] ));
+        } else {
+            board.ForEachThreat( attacker, eThreatThree, addThreat );
+        }
+        if( five ) {
+            return eNodeResult::eProven;
+        }
+        return moves.count > 0U ? eNodeResult::eUnknown : eNodeResult::eDisproven;
+    }
+
+    // defender to move, a four has one reply
+    const auto fives = Vcf::FiveCells( board, attacker, GetX( last ), GetY( last ), cells );
+    if( fives >= 2U ) {
+        return eNodeResult::eProven;
+    }
+    if( fives == 1U ) {
+        if( board.IsForbidden( defender, GetX( cells[0] ), GetY( cells[0] ))) {
+            return eNodeResult::eProven;
+        }
+        AddMove( moves, SetType( cells[0], defender ));
+        return eNodeResult::eUnknown;
+    }
+
+    // an open three is blocked around its last stone or answered by a four
+    auto complete = true;
+    for( uint32_t dir = 0U; dir < kDirCount; ++dir ) {
+        for( auto k = -kBlockDist; k <= kBlockDist; ++k ) {
+            const auto nx = static_cast<int>( GetX( last )) + k * kDirX[dir];
+            const auto ny = static_cast<int>( GetY( last )) + k * kDirY[dir];
+            if( board.GetDeskOrWall( nx, ny ) == eMove_t::eEmpty &&
+                !board.IsForbidden( defender, static_cast<coord_t>( nx ), static_cast<coord_t>( ny ))) {
+                complete = AddMove( moves, SetType( SetCoords( static_cast<coord_t>( nx ),
+                                                               static_cast<coord_t>( ny )), defender )) && complete;
+            }
+        }
+    }
+    board.ForEachThreat( defender, eThreatFour, [&]( const coord_t x, const coord_t y ) {
+        if( board.IsForbidden( defender, x, y )) {
+            return;
+        }
+        complete = AddMove( moves, SetType( SetCoords( x, y ), defender )) && complete;
+    } );
+
+    // a missing defence could make a false proof
+    if( !complete ) {
+        return eNodeResult::eDisproven;
+    }
+    return moves.count > 0U ? eNodeResult::eUnknown : eNodeResult::eProven;
+}
+
+void Vct::Mid( Board& board, const uint32_t ply, const uint32_t thPn, const uint32_t thDn ) {
+    if(( ++m_nodes & kCheckPeriod ) == 0U ) {
+        CheckLimits();
+    } else if( m_abort && m_abort->load( std::memory_order_relaxed )) {
+        m_stop = true;
+    }
+    if( m_stop ) {
+        return;
+    }
+
+    const auto key = board.GetKey();
+    NodeMoves  moves;
+    switch( Generate( board, ply, moves )) {
+        case eNodeResult::eProven:
+            Store( key, 0U, kInfinite );
+            return;
+        case eNodeResult::eDisproven:
+            Store( key, kInfinite, 0U );
+            return;
+        case eNodeResult::eUnknown:
+            break;
+    }
+
+    const auto orNode = ply % 2U == 0U;
+    while( true ) {
+        auto pn     = orNode ? kInfinite : 0U;
+        auto dn     = orNode ? 0U : kInfinite;
+        auto best   = 0U;
+        auto first  = kInfinite + 1U;
+        auto second = kInfinite;
+        auto bestPn = 0U;
+        auto bestDn = 0U;
+        for( auto i = 0U; i < moves.count; ++i ) {
+            uint32_t childPn;
+            uint32_t childDn;
+            Lookup( board.GetKeyAfter( moves.list[i] ), childPn, childDn );
+            if( orNode ) {
+                pn = std::min( pn, childPn );
+                dn = AddPn( dn, childDn );
+            } else {
+                pn = AddPn( pn, childPn );
+                dn = std::min( dn, childDn );
+            }
+            const auto value = orNode ? childPn : childDn;
+            if( value < first ) {
+                second = std::min( second, first );
+                first  = value;
+                best   = i;
+                bestPn = childPn;
+                bestDn = childDn;
+            } else if( value < second ) {
+                second = value;
+            }
+        }
+
+        if( pn >= thPn || dn >= thDn || m_stop ) {
+            Store( key, pn, dn );
+            return;
+        }
+
+        // the best child gets thresholds up to the second best sibling
+        const auto childThPn = orNode ? std::min( thPn, AddPn( second, 1U )) : AddPn( thPn - pn, bestPn );
+        const auto childThDn = orNode ? AddPn( thDn - dn, bestDn ) : std::min( thDn, AddPn( second, 1U ));
+        board.MakeMove( moves.list[best] );
+        Mid( board, ply + 1U, childThPn, childThDn );
+        board.UndoMove( moves.list[best] );
+    }
+}
+
+void Vct::ExtractLine( Board& board ) {
+    m_line.clear();
+    for( uint32_t ply = 0U; ply <= kMaxPly; ++ply ) {
+        NodeMoves  moves;
+        const auto result = Generate( board, ply, moves );
+        if( result == eNodeResult::eProven && ply % 2U == 0U ) {
+            m_line.push_back( moves.list[0] );
+        }
+        if( result != eNodeResult::eUnknown ) {
+            break;
+        }
+
+        // proven child of the attacker, the longest resisting defence
+        auto next   = MOVE_NONE;
+        auto nextDn = 0U;
+        for( auto i = 0U; i < moves.count; ++i ) {
+            uint32_t childPn;
+            uint32_t childDn;
+            Lookup( board.GetKeyAfter( moves.list[i] ), childPn, childDn );
+            if( childPn == 0U && ( !IsOk( next ) || ( ply % 2U == 1U && childDn > nextDn ))) {
+                next   = moves.list[i];
+                nextDn = childDn;
+            }
+        }
+        if( !IsOk( next )) {
+            break;
+        }
+        m_line.push_back( next );
+        board.MakeMove( next );
+    }
+
+    for( auto it = m_line.rbegin(); it != m_line.rend(); ++it ) {
+        if( board.GetGamePly() > 0U && board.GetLastMove() == *it ) {
+            board.UndoMove( *it );
+        }
+    }
+}
+
+Move Vct::Solve( Board& board, const uint32_t timeMs, const uint64_t maxNodes, const std::atomic_bool* abort ) {
+    m_nodes    = 0U;
+    m_maxNodes = maxNodes;
+    m_abort    = abort;
+    m_timeMs   = timeMs;
+    m_start    = std::chrono::steady_clock::now();
+    m_stop     = false;
+    m_attacker = board.SideToMove() ? eMove_t::eXX : eMove_t::eOO;
+    m_salt += kSaltStep;
+    m_line.clear();
+
+    Mid( board, 0U, kInfinite, kInfinite );
+
+    uint32_t pn;
+    uint32_t dn;
+    Lookup( board.GetKey(), pn, dn );
+    if( pn != 0U ) {
+        return MOVE_NONE;
+    }
+    ExtractLine( board );
+    return m_line.empty() ? MOVE_NONE : m_line.front();
+}
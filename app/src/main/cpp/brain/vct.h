@@ -0,0 +1,163 @@
+#ifndef VCT_H
+#define VCT_H
+
+/**
+ * @file vct.h
+ * @brief Victory by continuous threats, depth-first proof-number search
+ */
+
+#include "gameTypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+class Board;
+
+/**
+ * @class Vct
+ * @brief Prove a win by fours and open threes, the defender blocks the last threat or makes a four
+ */
+class Vct {
+public:
+    static constexpr uint32_t kMemoryShare = 4U;        /**< the proof table takes 1/kMemoryShare of MAX_MEMORY */
+    static constexpr uint32_t kTimeShare   = 4U;        /**< the solver takes 1/kTimeShare of the turn */
+    static constexpr uint32_t kMaxPly      = 24U;       /**< deepest proof, moves of both sides */
+    static constexpr uint32_t kMaxMoves    = 64U;       /**< moves generated in one node */
+    static constexpr uint32_t kInfinite    = 1U << 30U; /**< proof or disproof number of a solved node */
+
+    /**
+     * @brief Constructor
+     * @param maxMemory memory budget of the brain, see Resize()
+     */
+    explicit Vct( uint64_t maxMemory );
+    ~Vct() = default;                      /**< destructor */
+    Vct() = delete;                        /**< hidden default constructor */
+    Vct( const Vct& ) = delete;            /**< hidden copy constructor */
+    Vct( Vct&& ) = delete;                 /**< hidden move copy constructor */
+    Vct& operator=( const Vct& ) = delete; /**< hidden assignment operator @return this */
+    Vct& operator=( Vct&& ) = delete;      /**< hidden move assignment operator @return this */
+
+    /**
+     * @brief Reallocate the proof table, the biggest power of 2 entries within the budget
+     * @param maxMemory memory budget of the brain in bytes, the table takes a fixed share
+     */
+    void Resize( uint64_t maxMemory );
+
+    /**
+     * @brief Search a win for the side to move
+     * @param board position, restored after the search
+     * @param timeMs time limit in milliseconds, zero means no limit
+     * @param maxNodes node limit, zero means no limit
+     * @param abort external stop request polled in every node, can be nullptr
+     * @return first move of the win, MOVE_NONE if no win was proven
+     */
+    [[nodiscard]] Move Solve( Board& board, uint32_t timeMs, uint64_t maxNodes = 0U,
+                              const std::atomic_bool* abort = nullptr );
+
+    /**
+     * @brief Main line of the last proven win, attacker moves and best defences
+     */
+    [[nodiscard]] const std::vector<Move>& GetMainLine() const { return m_line; }
+
+    /**
+     * @brief Nodes visited by the last Solve()
+     */
+    [[nodiscard]] uint64_t GetNodes() const { return m_nodes; }
+
+    /**
+     * @brief Table size in bytes
+     */
+    [[nodiscard]] uint64_t GetSize() const { return m_entryCount * sizeof( Entry ); }
+
+private:
+    /**
+     * @enum eNodeResult
+     * @brief Static result of a node
+     */
+    enum class eNodeResult {
+        eUnknown,
+        eProven,
+        eDisproven
+    };
+
+    /**
+     * @struct Entry
+     * @brief Proof and disproof numbers of a position
+     */
+    struct Entry {
+        uint64_t key; /**< position key mixed with the search salt */
+        uint32_t pn;  /**< proof number */
+        uint32_t dn;  /**< disproof number */
+    };
+
+    /**
+     * @struct NodeMoves
+     * @brief Generated moves of one node
+     */
+    struct NodeMoves {
+        Move     list[kMaxMoves]; /**< moves */
+        uint32_t count = 0U;      /**< valid moves */
+    };
+
+    /**
+     * @brief Multiple iterative deepening of one node
+     * @param board position
+     * @param ply even for the attacker to move
+     * @param thPn proof number threshold
+     * @param thDn disproof number threshold
+     */
+    void Mid( Board& board, uint32_t ply, uint32_t thPn, uint32_t thDn );
+
+    /**
+     * @brief Threats of the attacker or defences of the defender
+     * @param board position
+     * @param ply even for the attacker to move
+     * @param moves generated moves, the winning five first for a proven attacker node
+     * @return static result
+     */
+    eNodeResult Generate( Board& board, uint32_t ply, NodeMoves& moves ) const;
+
+    /**
+     * @brief Add move if it is not in the list yet
+     * @return false if the list is full
+     */
+    static bool AddMove( NodeMoves& moves, Move m );
+
+    /**
+     * @brief Find the entry, pn = dn = 1 for unknown positions
+     */
+    void Lookup( uint64_t key, uint32_t& pn, uint32_t& dn ) const;
+
+    void Store( uint64_t key, uint32_t pn, uint32_t dn );
+
+    /**
+     * @brief Follow the proof from the root, fills m_line
+     */
+    void ExtractLine( Board& board );
+
+    /**
+     * @brief Test time and node limits, sets the stop flag
+     */
+    void CheckLimits();
+
+    [[nodiscard]] Entry& GetEntry( uint64_t key ) const { return m_table[key & ( m_entryCount - 1U )]; }
+
+    static constexpr uint32_t kCheckPeriod = 1023U; /**< nodes between two limit checks, 2^n - 1 */
+    static constexpr int      kBlockDist   = 5;     /**< defences of a three are this close to its last stone */
+
+    std::unique_ptr<Entry[]>              m_table;            /**< proof numbers */
+    uint64_t                              m_entryCount = 0U;  /**< power of 2 */
+    uint64_t                              m_salt       = 0U;  /**< makes entries of older searches unusable */
+    uint64_t                              m_nodes      = 0U;  /**< visited nodes */
+    uint64_t                              m_maxNodes   = 0U;  /**< node limit */
+    uint32_t                              m_timeMs     = 0U;  /**< time limit */
+    const std::atomic_bool*               m_abort      = nullptr; /**< external stop request */
+    std::chrono::steady_clock::time_point m_start;            /**< search start time */
+    eMove_t                               m_attacker   = eMove_t::eXX; /**< side to move at the root */
+    bool                                  m_stop       = false; /**< limit reached */
+    std::vector<Move>                     m_line;             /**< main line of the proven win */
+};
+
+#endif // VCT_H
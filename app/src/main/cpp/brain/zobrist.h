@@ -0,0 +1,82 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+/**
+ * @file zobrist.h
+ * @brief Zobrist hashing keys, generated at compile time
+ */
+
+#include "gameTypes.h"
+
+namespace Zobrist {
+    constexpr uint32_t kCells = kBoardSize * kMaxBoard; /**< key count per player */
+
+    /**
+     * @struct Keys
+     * @brief Random keys for every player and desk cell
+     */
+    struct Keys {
+        uint64_t piece[2][kCells]; /**< [eXX/eOO][coords] */
+        uint64_t side;             /**< toggled when eOO is to move */
+        uint64_t cell[kCells];     /**< stones of the symmetry keys, colours are mixed in later */
+    };
+
+    /**
+     * @brief splitmix64 step, good enough for hashing keys
+     * @param state generator state, updated
+     * @return next random value
+     */
+    [[nodiscard]] constexpr uint64_t SplitMix64( uint64_t& state ) {
+        auto z = ( state += 0x9E3779B97F4A7C15ULL );
+        z = ( z ^ ( z >> 30U )) * 0xBF58476D1CE4E5B9ULL;
+        z = ( z ^ ( z >> 27U )) * 0x94D049BB133111EBULL;
+        return z ^ ( z >> 31U );
+    }
+
+    /**
+     * @brief Fill all keys from a fixed seed
+     */
+    [[nodiscard]] constexpr Keys Generate() {
+        Keys     keys{};
+        uint64_t state = 0x6A09E667F3BCC909ULL;
+        for( auto& player : keys.piece ) {
+            for( auto& key : player ) {
+                key = SplitMix64( state );
+            }
+        }
+        keys.side = SplitMix64( state );
+        for( auto& key : keys.cell ) {
+            key = SplitMix64( state );
+        }
+        return keys;
+    }
+
+    inline constexpr Keys kKeys = Generate(); /**< the keys */
+
+    /**
+     * @brief Key of a stone
+     * @param player eXX or eOO
+     * @param coords desk index
+     */
+    [[nodiscard]] constexpr uint64_t PieceKey( const eMove_t player, const coords_t coords ) {
+        return kKeys.piece[player == eMove_t::eXX ? 0 : 1][coords];
+    }
+
+    /**
+     * @brief Key of the side to move, part of the position key if eOO is to move
+     */
+    [[nodiscard]] constexpr uint64_t SideKey() { return kKeys.side; }
+
+    /**
+     * @brief Key of a stone of any colour in the symmetry keys
+     * @param coords desk index of the transformed cell
+     */
+    [[nodiscard]] constexpr uint64_t CellKey( const coords_t coords ) { return kKeys.cell[coords]; }
+
+    /**
+     * @brief Key of the second player stones from their CellKey() sum, XOR and rotation commute
+     */
+    [[nodiscard]] constexpr uint64_t SecondColour( const uint64_t cells ) { return ( cells << 32U ) | ( cells >> 32U ); }
+}
+
+#endif // ZOBRIST_H
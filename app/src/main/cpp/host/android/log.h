@@ -0,0 +1,59 @@
+#ifndef HOST_ANDROID_LOG_H
+#define HOST_ANDROID_LOG_H
+
+/**
+ * @file android/log.h
+ * @brief Host (Linux) replacement of the NDK logging header
+ *
+ * Only the part of the NDK API used by the brain is provided. Messages are passed
+ * to a pluggable backend, release host builds (NDEBUG) compile every call to nothing.
+ */
+
+/**
+ * @enum android_LogPriority
+ * @brief Log priorities, same values as in the NDK
+ */
+enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT
+};
+
+namespace HostLog {
+    /** Backend signature, receives already formatted text */
+    using Backend = void ( * )( int prio, const char* tag, const char* text );
+
+    /**
+     * @brief Replace the log backend
+     * @param backend new backend, nullptr discards all messages
+     */
+    void SetBackend( Backend backend );
+
+    /**
+     * @brief Messages below this priority are not passed to the backend
+     * @param prio minimal priority, default is ANDROID_LOG_WARN
+     */
+    void SetMinPriority( int prio );
+}
+
+#if defined( NDEBUG ) && !defined( HOST_LOG_FORCE )
+
+#define __android_log_write( ... ) static_cast<void>( 0 )
+#define __android_log_print( ... ) static_cast<void>( 0 )
+
+#else
+
+int __android_log_write( int prio, const char* tag, const char* text );
+
+int __android_log_print( int prio, const char* tag, const char* fmt, ... )
+__attribute__(( format( printf, 3, 4 )));
+
+#endif
+
+#endif // HOST_ANDROID_LOG_H
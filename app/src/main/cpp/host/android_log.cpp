@@ -0,0 +1,61 @@
+/**
+ * @file android_log.cpp
+ * @brief Host (Linux) implementation of the NDK logging functions
+ */
+
+#include "android/log.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+    /**
+     * @brief Default backend, one line per message on stderr
+     */
+    void StdErrBackend( int prio, const char* tag, const char* text ) {
+        static constexpr char kPrioChar[] = "??VDIWEFS";
+        const auto            idx         = prio >= 0 && prio <= ANDROID_LOG_SILENT ? prio : 0;
+        std::fprintf( stderr, "%c/%s: %s\n", kPrioChar[idx], tag ? tag : "", text ? text : "" );
+    }
+
+    std::atomic<HostLog::Backend> gBackend{ StdErrBackend }; /**< current backend */
+    std::atomic_int               gMinPriority{ ANDROID_LOG_WARN }; /**< backend filter */
+}
+
+void HostLog::SetBackend( Backend backend ) {
+    gBackend = backend;
+}
+
+void HostLog::SetMinPriority( int prio ) {
+    gMinPriority = prio;
+}
+
+#if !defined( NDEBUG ) || defined( HOST_LOG_FORCE )
+
+int __android_log_write( int prio, const char* tag, const char* text ) {
+    const auto backend = gBackend.load();
+    if( backend == nullptr || prio < gMinPriority ) {
+        return 0;
+    }
+    backend( prio, tag, text );
+    return 1;
+}
+
+int __android_log_print( int prio, const char* tag, const char* fmt, ... ) {
+    const auto backend = gBackend.load();
+    if( backend == nullptr || prio < gMinPriority ) {
+        return 0;
+    }
+
+    char    buffer[1024];
+    va_list args;
+    va_start( args, fmt );
+    std::vsnprintf( buffer, sizeof( buffer ), fmt, args );
+    va_end( args );
+
+    backend( prio, tag, buffer );
+    return 1;
+}
+
+#endif
@@ -1,6 +1,6 @@
 #include "brain/engine.h"
+#include "brain/log.h"
 
-#include <android/log.h>
 #include <jni.h>
 
 #define CATCH_CONFIG_MAIN
@@ -42,9 +42,10 @@ Java_cz_fontan_gomoku_1gui_NativeInterface_00024Companion_readFromBrain( JNIEnv*
         return env->NewStringUTF( "" );
     }
 
-    const auto str = instance->ReadFromOutputQueue( timeoutMillis + 1 );
-    if( !str.empty()) {
-        __android_log_write( ANDROID_LOG_DEBUG, "JNI read", str.c_str());
+    // one reader thread, the buffer goes back to the engine by the next read
+    static std::string str;
+    if( instance->ReadFromOutputQueue( str, timeoutMillis + 1 )) {
+        BRAIN_LOG( ANDROID_LOG_DEBUG, "JNI read", str );
     }
     return env->NewStringUTF( str.c_str());
 }
@@ -55,7 +56,7 @@ Java_cz_fontan_gomoku_1gui_NativeInterface_00024Companion_writeToBrain( JNIEnv*
                                                                         jobject /* this */,
                                                                         jstring command ) {
     const auto str = env->GetStringUTFChars( command, nullptr );
-    __android_log_write( ANDROID_LOG_DEBUG, "JNI write", str );
+    BRAIN_LOG( ANDROID_LOG_DEBUG, "JNI write", str );
 
     if( str != nullptr ) {
         assert( instance != nullptr );
@@ -0,0 +1,75 @@
+/**
+ * @file pbrain.cpp
+ * @brief Gomocup/Piskvork console brain, Engine driven over stdin/stdout
+ *
+ * The engine runs its own command loop thread, a dedicated thread reads stdin
+ * and the main thread writes every response line as soon as it is available.
+ **/
+
+#include "../brain/engine.h"
+#include "../brain/keywords.h"
+
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+namespace {
+    constexpr int kOutputPollMs = 100; /**< wake up period to check the engine status */
+
+    /**
+     * @brief Test for END command, reading stops after it
+     * @param line one input line, already trimmed
+     */
+    bool IsEndCommand( const std::string& line ) {
+        return Keywords::EqualsUpper( line, "END" );
+    }
+
+    /**
+     * @brief Input thread, feed stdin lines to the engine until END or EOF
+     * @param engine target engine
+     */
+    void ReadInput( Engine& engine ) {
+        std::string line;
+        while( std::getline( std::cin, line )) {
+            line = Util::Trim( line );
+            if( line.empty()) {
+                continue;
+            }
+            engine.AddCommandsToInputQueue( line );
+            if( IsEndCommand( line )) {
+                return;
+            }
+        }
+        engine.AddCommandsToInputQueue( "END" );
+    }
+
+    /**
+     * @brief Write one response line and flush it immediately
+     * @param line response without new line
+     */
+    void WriteOutput( const std::string& line ) {
+        std::fwrite( line.data(), 1, line.size(), stdout );
+        std::fputc( '\n', stdout );
+        std::fflush( stdout );
+    }
+}
+
+int main() {
+    std::ios::sync_with_stdio( false );
+
+    Engine engine( kPlaySize );
+    engine.StartLoop();
+
+    auto reader = std::thread( ReadInput, std::ref( engine ));
+
+    // the line buffers circulate between the engine and this loop
+    std::string line;
+    while( engine.IsLoopRunning() || !engine.IsEmptyOutputQueue()) {
+        if( engine.ReadFromOutputQueue( line, kOutputPollMs )) {
+            WriteOutput( line );
+        }
+    }
+
+    reader.join();
+    return 0;
+}
@@ -0,0 +1,8 @@
+/**
+ * @file main_host.cpp
+ * @brief Catch2 runner for host (Linux) builds, Android uses native-lib.cpp
+ **/
+
+#define CATCH_CONFIG_MAIN
+
+#include "catch.hpp"
@@ -0,0 +1,525 @@
+/**
+ * @file test_board.cpp
+ * @brief Board representation tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/board.h"
+
+/**
+ * @brief Board Zobrist key test
+ */
+TEST_CASE( "Board, Key", "[All]" ) {
+    Board b( 15 );
+    CHECK( b.GetKey() == 0 );
+
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    const auto k1 = b.GetKey();
+    CHECK( k1 != 0 );
+    CHECK( k1 == b.ComputeKey());
+    b.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+    const auto k2 = b.GetKey();
+    CHECK( k2 != k1 );
+
+    b.UndoMove( createMove<eMove_t::eOO>( 8, 8 ));
+    CHECK( b.GetKey() == k1 );
+    b.UndoMove( createMove<eMove_t::eXX>( 7, 7 ));
+    CHECK( b.GetKey() == 0 );
+
+    // transposition gives the same key
+    Board c( 15 );
+    c.MakeMove( createMove<eMove_t::eXX>( 1, 1 ));
+    c.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+    c.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    c.UndoMove( createMove<eMove_t::eXX>( 7, 7 ));
+    c.UndoMove( createMove<eMove_t::eOO>( 8, 8 ));
+    c.UndoMove( createMove<eMove_t::eXX>( 1, 1 ));
+    CHECK( c.GetKey() == 0 );
+
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 1, 1 ));
+    c.MakeMove( createMove<eMove_t::eXX>( 1, 1 ));
+    c.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+    c.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    CHECK( b.GetKey() == c.GetKey());
+    CHECK( Board( b ).GetKey() == b.GetKey());
+}
+
+/**
+ * @brief Board side to move is part of the key
+ */
+TEST_CASE( "Board, KeySideToMove", "[All]" ) {
+    Board b( 15 );
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    const auto k1 = b.GetKey();
+    CHECK( !b.SideToMove());
+
+    b.SetSideToMove( false );
+    CHECK( b.GetKey() == k1 );
+    b.SwitchSideToMove();
+    CHECK( b.SideToMove());
+    CHECK( b.GetKey() != k1 );
+    CHECK( b.IsKeyConsistent());
+    b.SetSideToMove( false );
+    CHECK( b.GetKey() == k1 );
+
+    // the same stones with a different side to move differ
+    Board c( 15 );
+    c.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    c.MakeMove( createMove<eMove_t::eXX>( 8, 8 ));
+    c.MakeMove( createMove<eMove_t::eOO>( 9, 9 ));
+    Board d( 15 );
+    d.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    d.MakeMove( createMove<eMove_t::eOO>( 9, 9 ));
+    d.MakeMove( createMove<eMove_t::eXX>( 8, 8 ));
+    CHECK( c.GetKey() != d.GetKey());
+    d.SetSideToMove( true );
+    CHECK( c.GetKey() == d.GetKey());
+    CHECK( d.IsKeyConsistent());
+
+    d.Reset();
+    CHECK( d.GetKey() == 0 );
+    CHECK( d.IsKeyConsistent());
+}
+
+/**
+ * @brief Last move five in all directions and at the edges
+ */
+TEST_CASE( "Board, LastMoveFive", "[All]" ) {
+    Board b( 15 );
+    CHECK( !b.IsLastMoveFive());
+
+    // open four on the anti-diagonal
+    b.MakeMove( createMove<eMove_t::eXX>( 5, 9 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 6, 8 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 8, 6 ));
+    CHECK( !b.IsLastMoveFive());
+
+    // blocked on one side
+    b.MakeMove( createMove<eMove_t::eOO>( 9, 5 ));
+    CHECK( !b.IsLastMoveFive());
+    b.MakeMove( createMove<eMove_t::eXX>( 4, 10 ));
+    CHECK( b.IsLastMoveFive());
+    b.UndoMove( createMove<eMove_t::eXX>( 4, 10 ));
+    CHECK( !b.IsLastMoveFive());
+
+    // the board edge blocks like a stone
+    Board c( 15 );
+    for( coord_t y = 0; y < 4; y++ ) {
+        c.MakeMove( createMove<eMove_t::eOO>( 14, y ));
+        c.MakeMove( createMove<eMove_t::eOO>( 0, 11 + y ));
+    }
+    CHECK( !c.IsLastMoveFive());
+    c.MakeMove( createMove<eMove_t::eOO>( 0, 10 ));
+    CHECK( c.IsLastMoveFive());
+
+    // five along the x axis
+    for( coord_t x = 2; x < 7; x++ ) {
+        c.MakeMove( createMove<eMove_t::eXX>( x, 3 ));
+    }
+    CHECK( c.IsLastMoveFive());
+}
+
+
+/**
+ * @brief Board copies keep the move history in the played order
+ */
+TEST_CASE( "Board, Copy", "[All]" ) {
+    Board b( 15 );
+    const Move moves[] = { createMove<eMove_t::eXX>( 9, 9 ), createMove<eMove_t::eOO>( 1, 2 ),
+                           createMove<eMove_t::eXX>( 7, 7 ), createMove<eMove_t::eOO>( 0, 14 ) };
+    for( const auto m : moves ) {
+        b.MakeMove( m );
+    }
+
+    const auto same = []( const Board& a, const Board& c ) {
+        auto ok = a.GetGamePly() == c.GetGamePly() && a.GetKey() == c.GetKey() &&
+                  a.SideToMove() == c.SideToMove() && a.GetDimX() == c.GetDimX() && a.GetDimY() == c.GetDimY();
+        for( size_t i = 0U; ok && i < a.GetGamePly(); ++i ) {
+            ok = a[i] == c[i];
+        }
+        for( coord_t x = 0; ok && x < a.GetDimX(); x++ ) {
+            for( coord_t y = 0; y < a.GetDimY(); y++ ) {
+                ok = ok && a.GetPattern( eMove_t::eXX, x, y, 0U ) == c.GetPattern( eMove_t::eXX, x, y, 0U );
+            }
+        }
+        return ok;
+    };
+
+    Board c( b );
+    CHECK( same( b, c ));
+    CHECK( c.GetLastMove() == moves[3] );
+
+    // copies are independent
+    c.UndoMove( moves[3] );
+    CHECK( b.GetLastMove() == moves[3] );
+    CHECK( c.GetLastMove() == moves[2] );
+
+    // reused worker board of other size
+    Board w( 20, 10 );
+    w.MakeMove( createMove<eMove_t::eXX>( 19, 9 ));
+    w = b;
+    CHECK( same( b, w ));
+    CHECK( w.GetDeskOrWall( 19, 9 ) == eMove_t::eBlock );
+    w.UndoMove( moves[3] );
+    CHECK( same( c, w ));
+
+    c = b;
+    CHECK( same( b, c ));
+}
+
+/**
+ * @brief Packed moves and desk cells keep coordinates and pieces, walls are blocked
+ */
+TEST_CASE( "Board, Packed", "[All]" ) {
+    const auto m = createMove<eMove_t::eOO>( 31, 17 );
+    CHECK( GetX( m ) == 31 );
+    CHECK( GetY( m ) == 17 );
+    CHECK( GetType( m ) == eMove_t::eOO );
+    CHECK( GetCoords( m ) == 31 * kBoardSize + 17 );
+    CHECK( SetType( m, eMove_t::eXX ) == createMove<eMove_t::eXX>( 31, 17 ));
+    CHECK( HaveSameCoords( m, SetCoords( 31, 17 )));
+    CHECK( !IsOk( SetCoords( 31, 17 )));
+
+    Board b( 20, 15 );
+    b.MakeMove( createMove<eMove_t::eXX>( 19, 14 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 19, 13 ));
+    CHECK( b.GetDesk( 19, 14 ) == eMove_t::eXX );
+    CHECK( b.GetDesk( 19, 13 ) == eMove_t::eOO );
+    CHECK( b.GetDesk( 18, 14 ) == eMove_t::eEmpty );
+    CHECK( b.GetDeskOrWall( 20, 14 ) == eMove_t::eBlock );
+    CHECK( b.GetDeskOrWall( 19, 15 ) == eMove_t::eBlock );
+    CHECK( b.GetDeskOrWall( -1, 0 ) == eMove_t::eBlock );
+    b.UndoMove( createMove<eMove_t::eOO>( 19, 13 ));
+    CHECK( b.GetDesk( 19, 13 ) == eMove_t::eEmpty );
+    CHECK( b.GetDesk( 19, 14 ) == eMove_t::eXX );
+}
+
+/**
+ * @brief Incremental candidate and threat sets match a scan of the desk
+ */
+TEST_CASE( "Board, Candidates", "[All]" ) {
+    const auto verify = []( const Board& b ) {
+        bool candidate[kMaxBoard][kBoardSize] = {};
+        bool threat[2][eThreatCount][kMaxBoard][kBoardSize] = {};
+        auto errors = 0U;
+        auto last   = -1;
+        b.ForEachCandidate( [&]( const coord_t x, const coord_t y ) {
+            errors += static_cast<int>( x * kBoardSize + y ) > last ? 0U : 1U;
+            last = static_cast<int>( x * kBoardSize + y );
+            candidate[x][y] = true;
+        } );
+        for( uint32_t level = 0U; level < eThreatCount; ++level ) {
+            const auto threatLevel = static_cast<eThreat>( level );
+            b.ForEachThreat( eMove_t::eXX, threatLevel, [&]( const coord_t x, const coord_t y ) {
+                threat[0][level][x][y] = true;
+            } );
+            b.ForEachThreat( eMove_t::eOO, threatLevel, [&]( const coord_t x, const coord_t y ) {
+                threat[1][level][x][y] = true;
+            } );
+        }
+
+        for( coord_t x = 0; x < b.GetDimX(); x++ ) {
+            for( coord_t y = 0; y < b.GetDimY(); y++ ) {
+                const auto empty = b.GetDesk( x, y ) == eMove_t::eEmpty;
+                auto       near  = false;
+                for( auto dx = -2; dx <= 2; ++dx ) {
+                    for( auto dy = -2; dy <= 2; ++dy ) {
+                        const auto piece = b.GetDeskOrWall( static_cast<int>( x ) + dx, static_cast<int>( y ) + dy );
+                        near = near || piece == eMove_t::eXX || piece == eMove_t::eOO;
+                    }
+                }
+                errors += candidate[x][y] == ( empty && near ) ? 0U : 1U;
+                errors += b.IsCandidate( x, y ) == candidate[x][y] ? 0U : 1U;
+
+                for( uint32_t player = 0U; player < 2U; ++player ) {
+                    auto best = ePatNone;
+                    for( uint32_t dir = 0U; empty && dir < kDirCount; ++dir ) {
+                        best = std::max( best, b.GetPattern( player == 0U ? eMove_t::eXX : eMove_t::eOO, x, y, dir ));
+                    }
+                    for( uint32_t level = 0U; level < eThreatCount; ++level ) {
+                        errors += threat[player][level][x][y] == ( best >= kThreatPattern[level] ) ? 0U : 1U;
+                    }
+                }
+            }
+        }
+        return errors;
+    };
+
+    Board b( 15, 12 );
+    CHECK( verify( b ) == 0 );
+    b.ForEachCandidate( []( coord_t, coord_t ) { FAIL( "empty board has no candidates" ); } );
+
+    b.MakeMove( createMove<eMove_t::eXX>( 0, 0 ));
+    auto count = 0U;
+    b.ForEachCandidate( [&count]( coord_t, coord_t ) { ++count; } );
+    CHECK( count == 8 );
+    CHECK( b.IsCandidate( 2, 2 ));
+    CHECK( !b.IsCandidate( 0, 0 ));
+    CHECK( !b.IsCandidate( 3, 0 ));
+
+    b.MakeMove( createMove<eMove_t::eXX>( 5, 5 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 5, 6 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 5, 7 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 5, 8 ));
+    count = 0U;
+    b.ForEachThreat( eMove_t::eXX, eThreatFive, [&count]( coord_t x, coord_t y ) {
+        CHECK( x == 5 );
+        CHECK(( y == 4 || y == 9 ));
+        ++count;
+    } );
+    CHECK( count == 2 );
+    CHECK( verify( b ) == 0 );
+    b.UndoMove( createMove<eMove_t::eXX>( 5, 8 ));
+    CHECK( verify( b ) == 0 );
+    for( const coord_t y : { 7U, 6U, 5U } ) {
+        b.UndoMove( createMove<eMove_t::eXX>( 5, y ));
+    }
+    b.UndoMove( createMove<eMove_t::eXX>( 0, 0 ));
+    CHECK( verify( b ) == 0 );
+    CHECK( !b.IsCandidate( 2, 2 ));
+
+    // random games with take backs
+    for( auto game = 0; game < 10; ++game ) {
+        b.Reset();
+        for( auto ply = 0; ply < 60; ++ply ) {
+            const auto m = ply % 2 == 0 ? b.GenerateRandomMove<eMove_t::eXX>()
+                                        : b.GenerateRandomMove<eMove_t::eOO>();
+            b.MakeMove( m );
+            if( ply % 7 == 6 ) {
+                b.UndoMove( m );
+            }
+        }
+        CHECK( verify( b ) == 0 );
+        CHECK( verify( Board( b )) == 0 );
+    }
+}
+
+/**
+ * @brief Symmetry keys follow the stones, rotations and reflections share the canonical key
+ */
+TEST_CASE( "Board, Symmetry", "[All]" ) {
+    Board b( 15 );
+    CHECK( b.GetSymmetryCount() == Board::kSymmetries );
+    CHECK( Board( 15, 20 ).GetSymmetryCount() == Board::kSymmetries / 2U );
+    for( uint32_t s = 0U; s < Board::kSymmetries; ++s ) {
+        coord_t x = 3;
+        coord_t y = 11;
+        b.Transform( s, x, y );
+        CHECK( x < 15U );
+        CHECK( y < 15U );
+        b.InverseTransform( s, x, y );
+        CHECK( x == 3U );
+        CHECK( y == 11U );
+    }
+
+    const Move line[] = { createMove<eMove_t::eXX>( 7, 7 ), createMove<eMove_t::eOO>( 8, 9 ),
+                          createMove<eMove_t::eXX>( 2, 4 ), createMove<eMove_t::eOO>( 14, 0 ) };
+    for( const auto m : line ) {
+        b.MakeMove( m );
+    }
+    for( uint32_t s = 0U; s < Board::kSymmetries; ++s ) {
+        CHECK( b.GetSymmetryKey( s, eMove_t::eXX ) == b.ComputeSymmetryKey( s, eMove_t::eXX ));
+        CHECK( b.GetSymmetryKey( s, eMove_t::eOO ) == b.ComputeSymmetryKey( s, eMove_t::eOO ));
+        CHECK( b.GetSymmetryKey( s, eMove_t::eXX ) != b.GetSymmetryKey( s, eMove_t::eOO ));
+    }
+
+    uint32_t   symmetry = 0U;
+    const auto key      = b.GetCanonicalKey( eMove_t::eXX, symmetry );
+    CHECK( key == b.GetSymmetryKey( symmetry, eMove_t::eXX ));
+    for( uint32_t s = 0U; s < Board::kSymmetries; ++s ) {
+        // the colours are swapped too, the first player is eOO then
+        Board t( 15 );
+        for( const auto m : line ) {
+            auto x = GetX( m );
+            auto y = GetY( m );
+            b.Transform( s, x, y );
+            t.MakeMove( SetType( SetCoords( x, y ), GetOpponent( GetType( m ))));
+        }
+        uint32_t other = 0U;
+        CHECK( t.GetCanonicalKey( eMove_t::eOO, other ) == key );
+        CHECK( t.GetCanonicalKey( eMove_t::eXX, other ) != key );
+    }
+
+    const Board c( b );
+    CHECK( c.GetCanonicalKey( eMove_t::eXX, symmetry ) == key );
+    b.UndoMove( line[3] );
+    CHECK( b.GetSymmetryKey( 5U, eMove_t::eXX ) == b.ComputeSymmetryKey( 5U, eMove_t::eXX ));
+    CHECK( b.GetCanonicalKey( eMove_t::eXX, symmetry ) != key );
+    b.MakeMove( line[3] );
+    CHECK( b.GetCanonicalKey( eMove_t::eXX, symmetry ) == key );
+    b.Reset();
+    CHECK( b.GetSymmetryKey( 7U, eMove_t::eXX ) == 0U );
+
+    // the mirrors of a rectangle
+    Board r( 15, 20 );
+    r.MakeMove( createMove<eMove_t::eXX>( 1, 2 ));
+    Board m( 15, 20 );
+    m.MakeMove( createMove<eMove_t::eXX>( 13, 17 ));
+    CHECK( r.GetCanonicalKey( eMove_t::eXX, symmetry ) == m.GetCanonicalKey( eMove_t::eXX, symmetry ));
+    CHECK( symmetry < r.GetSymmetryCount());
+}
+
+/**
+ * @brief The first five decides the game, take backs and copies keep the result
+ */
+TEST_CASE( "Board, Winner", "[All]" ) {
+    Board b( 15 );
+    CHECK( b.GetWinner() == eMove_t::eEmpty );
+    for( coord_t y = 0; y < 4; y++ ) {
+        b.MakeMove( createMove<eMove_t::eXX>( 3, y ));
+        CHECK( !b.IsLastMoveFive());
+        b.MakeMove( createMove<eMove_t::eOO>( 9, y ));
+    }
+    CHECK( b.GetBlack() == eMove_t::eXX );
+    CHECK( b.GetWinner() == eMove_t::eEmpty );
+
+    b.MakeMove( createMove<eMove_t::eXX>( 3, 4 ));
+    CHECK( b.IsLastMoveFive());
+    CHECK( b.GetWinner() == eMove_t::eXX );
+    b.MakeMove( createMove<eMove_t::eOO>( 9, 4 ));
+    CHECK( b.IsLastMoveFive());
+    CHECK( b.GetWinner() == eMove_t::eXX );
+
+    const Board c( b );
+    CHECK( c.IsLastMoveFive());
+    CHECK( c.GetWinner() == eMove_t::eXX );
+
+    b.UndoMove( createMove<eMove_t::eOO>( 9, 4 ));
+    CHECK( b.GetWinner() == eMove_t::eXX );
+    b.UndoMove( createMove<eMove_t::eXX>( 3, 4 ));
+    CHECK( !b.IsLastMoveFive());
+    CHECK( b.GetWinner() == eMove_t::eEmpty );
+    b.MakeMove( createMove<eMove_t::eXX>( 8, 8 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 9, 4 ));
+    CHECK( b.GetWinner() == eMove_t::eOO );
+    CHECK( b.GetBlack() == eMove_t::eXX );
+
+    b.Reset();
+    CHECK( b.GetWinner() == eMove_t::eEmpty );
+    CHECK( !b.IsLastMoveFive());
+}
+
+/**
+ * @brief Exact five and renju rules, forbidden moves of black
+ */
+TEST_CASE( "Board, Rules", "[All]" ) {
+    Board b( 15 );
+    // eXX stays black, the side to move follows the ply
+    const auto put = [&b]( const eMove_t piece, const coord_t x, const coord_t y ) {
+        b.MakeMove( piece == eMove_t::eXX ? createMove<eMove_t::eXX>( x, y ) : createMove<eMove_t::eOO>( x, y ));
+        b.SetSideToMove( b.GetGamePly() % 2U == 0U );
+    };
+    const auto undo = [&b]() {
+        b.UndoMove( b.GetLastMove());
+        b.SetSideToMove( b.GetGamePly() % 2U == 0U );
+    };
+
+    // overline
+    for( const coord_t x : { 2U, 3U, 4U, 6U, 7U } ) {
+        put( eMove_t::eXX, x, 7 );
+        put( eMove_t::eOO, x, 0 );
+    }
+    CHECK( b.GetBlack() == eMove_t::eXX );
+    CHECK( b.IsFive( eMove_t::eXX, 5, 7 ));
+    CHECK( !b.IsForbidden( eMove_t::eXX, 5, 7 ));
+    b.SetRule( eRuleExactFive );
+    CHECK( !b.IsFive( eMove_t::eXX, 5, 7 ));
+    CHECK( !b.IsForbidden( eMove_t::eXX, 5, 7 ));
+    b.SetRule( eRuleRenju );
+    CHECK( !b.IsFive( eMove_t::eXX, 5, 7 ));
+    CHECK( b.IsForbidden( eMove_t::eXX, 5, 7 ));
+    CHECK( b.IsFive( eMove_t::eOO, 5, 0 ));
+    CHECK( !b.IsForbidden( eMove_t::eOO, 5, 0 ));
+    put( eMove_t::eXX, 5, 7 );
+    CHECK( !b.IsLastMoveFive());
+    CHECK( b.GetWinner() == eMove_t::eEmpty );
+    undo();
+    b.SetRule( eRuleFreestyle );
+    put( eMove_t::eXX, 5, 7 );
+    CHECK( b.IsLastMoveFive());
+    CHECK( b.GetWinner() == eMove_t::eXX );
+
+    // double three, forbidden until one three is blocked
+    b.Reset();
+    b.SetRule( eRuleRenju );
+    CHECK( b.GetRule() == eRuleRenju );
+    put( eMove_t::eXX, 5, 7 );
+    put( eMove_t::eOO, 0, 14 );
+    put( eMove_t::eXX, 6, 7 );
+    put( eMove_t::eOO, 2, 14 );
+    put( eMove_t::eXX, 7, 5 );
+    put( eMove_t::eOO, 4, 14 );
+    put( eMove_t::eXX, 7, 6 );
+    CHECK( b.IsForbidden( eMove_t::eXX, 7, 7 ));
+    put( eMove_t::eOO, 9, 7 );
+    CHECK( b.IsForbidden( eMove_t::eXX, 7, 7 ));
+    put( eMove_t::eXX, 14, 14 );
+    put( eMove_t::eOO, 3, 7 );
+    CHECK( !b.IsForbidden( eMove_t::eXX, 7, 7 ));
+    undo();
+    CHECK( b.IsForbidden( eMove_t::eXX, 7, 7 ));
+
+    // four three is allowed, double four is not
+    b.Reset();
+    for( const coord_t k : { 4U, 5U, 6U } ) {
+        put( eMove_t::eXX, k, 7 );
+        put( eMove_t::eOO, k, 14 );
+    }
+    put( eMove_t::eXX, 7, 5 );
+    put( eMove_t::eOO, 14, 0 );
+    put( eMove_t::eXX, 7, 6 );
+    put( eMove_t::eOO, 14, 2 );
+    CHECK( !b.IsForbidden( eMove_t::eXX, 7, 7 ));
+    put( eMove_t::eXX, 7, 4 );
+    put( eMove_t::eOO, 14, 4 );
+    CHECK( b.IsForbidden( eMove_t::eXX, 7, 7 ));
+    // a five wins over the double four
+    put( eMove_t::eXX, 8, 7 );
+    put( eMove_t::eOO, 14, 6 );
+    CHECK( !b.IsForbidden( eMove_t::eXX, 7, 7 ));
+
+    // a three is not real if its open fours are forbidden overlines
+    b.Reset();
+    auto white = coord_t{ 0U };
+    for( const auto& cell : std::vector<std::pair<coord_t, coord_t>>{
+            { 5, 7 }, { 6, 7 }, { 7, 5 }, { 7, 6 }, { 4, 4 }, { 4, 5 }, { 4, 6 }, { 4, 8 }, { 4, 9 }, { 4, 10 },
+            { 8, 4 }, { 8, 5 }, { 8, 6 }, { 8, 8 }, { 8, 9 }, { 8, 10 }} ) {
+        put( eMove_t::eXX, cell.first, cell.second );
+        put( eMove_t::eOO, static_cast<coord_t>( white % 8U * 2U ), white < 8U ? 14U : 0U );
+        ++white;
+    }
+    CHECK( b.IsForbidden( eMove_t::eXX, 4, 7 ));
+    CHECK( b.IsForbidden( eMove_t::eXX, 8, 7 ));
+    CHECK( !b.IsForbidden( eMove_t::eXX, 7, 7 ));
+
+    // the cache follows the moves
+    for( auto game = 0; game < 10; ++game ) {
+        b.Reset();
+        for( auto ply = 0; ply < 60; ++ply ) {
+            for( coord_t x = 4; x < 11; x++ ) {
+                for( coord_t y = 4; y < 11; y++ ) {
+                    static_cast<void>( b.IsForbidden( eMove_t::eXX, x, y ));
+                }
+            }
+            const auto m = ply % 2 == 0 ? b.GenerateRandomMove<eMove_t::eXX>()
+                                        : b.GenerateRandomMove<eMove_t::eOO>();
+            b.MakeMove( m );
+            if( ply % 7 == 6 ) {
+                b.UndoMove( m );
+            }
+        }
+        auto fresh = b;
+        fresh.SetRule( eRuleRenju );
+        auto errors = 0U;
+        for( coord_t x = 0; x < b.GetDimX(); x++ ) {
+            for( coord_t y = 0; y < b.GetDimY(); y++ ) {
+                errors += b.IsForbidden( b.GetBlack(), x, y ) == fresh.IsForbidden( b.GetBlack(), x, y ) ? 0U : 1U;
+            }
+        }
+        CHECK( errors == 0 );
+    }
+}
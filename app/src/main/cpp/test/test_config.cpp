@@ -21,6 +21,11 @@ TEST_CASE( "Config, Default", "[All]" ) {
     CHECK( c.GetTimeInc() == 0 );
     CHECK( c.GetTimeoutMatch() == 0 );
     CHECK( c.GetTimeoutTurn() == 0 );
+    CHECK( c.GetThreadNum() == 1 );
+    CHECK( !c.GetPonder());
+    CHECK( !c.GetPowerSave());
+    CHECK( !c.GetUseDatabase());
+    CHECK( c.GetFolder().empty());
 //    CHECK( c.GetRule() == static_cast<int>( BuildOptions::GameRule ) );
 }
 
@@ -31,6 +36,9 @@ TEST_CASE( "Config, SetGet", "[All]" ) {
     Config c;
     CHECK( c.SetContinuous( 1 ).GetContinuous() == 1 );
     CHECK( c.SetRule( 1 ).GetRule() == 1 );
+    CHECK( c.GetBoardRule() == eRuleExactFive );
+    CHECK( c.SetRule( 5 ).GetBoardRule() == eRuleRenju );
+    CHECK( c.SetRule( 2 ).GetBoardRule() == eRuleFreestyle );
     CHECK( c.SetGameType( 2 ).GetGameType() == 2 );
     CHECK( c.SetMaxMemory( 10000000 ).GetMaxMemory() == 10000000 );
     CHECK( c.SetMaxMemory( 0 ).GetMaxMemory() == kTTMemorySize );
@@ -41,4 +49,12 @@ TEST_CASE( "Config, SetGet", "[All]" ) {
     CHECK( c.SetTimeoutMatch( 10000 ).GetTimeoutMatch() == 10000 );
     CHECK( c.SetTimeoutTurn( 5000 ).GetTimeoutTurn() == 5000 );
     CHECK( c.SetLimitNodes( 9223372036854775807ULL ).GetLimitNodes() == 9223372036854775807ULL );
+    CHECK( c.SetThreadNum( 8 ).GetThreadNum() == 8 );
+    CHECK( c.SetThreadNum( 0 ).GetThreadNum() == 1 );
+    CHECK( c.SetThreadNum( 1000 ).GetThreadNum() == kMaxThreads );
+    CHECK( c.SetPonder( true ).IsPonderActive());
+    CHECK( !c.SetPowerSave( true ).IsPonderActive());
+    CHECK( c.GetPonder());
+    CHECK( c.SetUseDatabase( true ).GetUseDatabase());
+    CHECK( c.SetFolder( "/data/Brain" ).GetFolder() == "/data/Brain" );
 }
@@ -37,94 +37,226 @@ TEST_CASE( "Engine, ReadInputLine", "[All]" ) {
     CHECK( e.ReadInputLine() == "TEST1" );
     CHECK( e.ReadInputLine() == "TEST2" );
     CHECK( !e.HasReaderInput());
+
+    // lines are not upper cased, the parsers ignore the case
+    e.AddCommandsToInputQueue( "info folder /Data/Book\nturn 1,2\n" );
+    CHECK( e.ReadInputLine() == "info folder /Data/Book" );
+    CHECK( e.ReadInputLine() == "turn 1,2" );
+    CHECK( !e.HasReaderInput());
+}
+
+/**
+ * @brief Engine drops the lines not fitting to the full input queue, the call does not wait
+ */
+TEST_CASE( "Engine, InputQueueFull", "[All]" ) {
+    Engine e( 15 );
+
+    std::string burst;
+    for( auto i = 0U; i < Engine::kInputLines + 10U; ++i ) {
+        burst += "about\n";
+    }
+    e.AddCommandsToInputQueue( burst );
+    CHECK( e.GetLastPipeOut() == "ERROR input queue full, 10 lines dropped" );
+    e.AddCommandsToInputQueue( "about" );
+    CHECK( e.GetLastPipeOut() == "ERROR input queue full, 1 lines dropped" );
+
+    auto lines = 0U;
+    while( e.HasReaderInput()) {
+        CHECK( e.ReadInputLine() == "about" );
+        ++lines;
+    }
+    CHECK( lines == Engine::kInputLines );
+
+    // the loop drains a queue filled again, StopLoop() of the destructor gets a slot
+    e.AddCommandsToInputQueue( burst );
+    e.StartLoop();
+    std::string line;
+    for( auto i = 0U; i < Engine::kInputLines; ++i ) {
+        REQUIRE( e.ReadFromOutputQueue( line, 1000 ));
+    }
+}
+
+/**
+ * @brief Engine drops MESSAGE lines of a full output queue, answers wait for the reader
+ */
+TEST_CASE( "Engine, OutputQueueFull", "[All]" ) {
+    Engine e( 15 );
+    CHECK( e.CmdExecute( "start 15" ));
+    for( auto i = 1U; i < Engine::kOutputLines; ++i ) {
+        CHECK( e.CmdExecute( "about" ));
+    }
+    CHECK( e.GetDroppedLines() == 0U );
+
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT NONE" );
+    CHECK( e.GetDroppedLines() == 1U );
+    CHECK( e.ReadFromOutputQueue( 1000 ) == "OK" );
+}
+
+/**
+ * @brief Engine closes with a full output queue nobody reads, the blocked loop does not hang the destructor
+ */
+TEST_CASE( "Engine, CloseFullOutput", "[All]" ) {
+    auto e = std::make_unique<Engine>( 15 );
+    e->StartLoop();
+
+    std::string burst;
+    for( auto i = 0U; i < Engine::kInputLines; ++i ) {
+        burst += "about\n";
+    }
+    e->AddCommandsToInputQueue( burst );
+    while( e->HasReaderInput()) {
+        std::this_thread::yield();
+    }
+
+    // the output queue is full, the loop waits for a free slot with the next lines unread
+    e->AddCommandsToInputQueue( burst );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ));
+    CHECK( e->HasReaderInput());
+    e.reset();
 }
 
 /**
  * @brief Engine ParseCmd and parse line test
  */
 TEST_CASE( "Engine, ParseCmd", "[All]" ) {
-    Engine      e( 20 );
-    std::string rest;
+    Engine           e( 20 );
+    std::string      line;
+    std::string_view rest;
     e.AddCommandsToInputQueue( "xxxx" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eUnknown );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eUnknown );
 
     e.AddCommandsToInputQueue( "About" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eAbout );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eAbout );
 
     e.AddCommandsToInputQueue( "Start 15" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eStart );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eStart );
     auto        v = Util::ParseNumbers( rest, " " );
     CHECK( v.size() == 1 );
     CHECK( v[0] == 15 );
 
     e.AddCommandsToInputQueue( "Start 15 20" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eStart );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eStart );
     v = Util::ParseNumbers( rest, " ," );
     CHECK( v.size() == 2 );
     CHECK( v[0] == 15 );
 
     e.AddCommandsToInputQueue( "Start" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eStart );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eStart );
     v = Util::ParseNumbers( rest, " " );
     CHECK( v.empty());
 
     e.AddCommandsToInputQueue( "yxboard" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eYxBoard );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eYxBoard );
     v = Util::ParseNumbers( rest, " " );
     CHECK( v.empty());
 
     e.AddCommandsToInputQueue( "turn       1       ,      1     " );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eTurn );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eTurn );
     v = Util::ParseNumbers( rest, "," );
     CHECK( v.size() == 2 );
     CHECK( v[0] == 1 );
     CHECK( v[1] == 1 );
+
+    // whole words in any case, the rest keeps its case
+    CHECK( e.ParseCmd( "info\tFolder /Tmp/Book ", rest ) == Engine::eCommand::eInfo );
+    CHECK( rest == "Folder /Tmp/Book" );
+    CHECK( e.ParseCmd( "yXsHoWfOrBiD", rest ) == Engine::eCommand::eYxShowForbid );
+    CHECK( rest.empty());
+    CHECK( e.ParseCmd( "ENDX", rest ) == Engine::eCommand::eUnknown );
+    CHECK( e.ParseCmd( "EN", rest ) == Engine::eCommand::eUnknown );
+    CHECK( e.ParseCmd( " END", rest ) == Engine::eCommand::eUnknown );
+    CHECK( e.ParseCmd( "", rest ) == Engine::eCommand::eUnknown );
+    CHECK( e.ParseCmd( "YXSTART 1", rest ) == Engine::eCommand::eUnknown );
+    CHECK( rest.empty());
+}
+
+/**
+ * @brief Numbers of protocol lines, strtoll() rules
+ */
+TEST_CASE( "Engine, ParseNumbers", "[All]" ) {
+    auto v = Util::ParseNumbers( " +7 ,\t-8 , 9x", "," );
+    REQUIRE( v.size() == 3 );
+    CHECK( v[0] == 7 );
+    CHECK( v[1] == -8 );
+    CHECK( v[2] == 9 );
+
+    // the first token without a number ends the parsing
+    v = Util::ParseNumbers( "1,x,2", "," );
+    CHECK( v.size() == 1 );
+    v = Util::ParseNumbers( "+-1", "," );
+    CHECK( v.empty());
+    v = Util::ParseNumbers( "1, ,2", "," );
+    CHECK( v.size() == 1 );
+
+    // out of range values saturate
+    v = Util::ParseNumbers( "99999999999999999999 -99999999999999999999", " " );
+    REQUIRE( v.size() == 2 );
+    CHECK( v[0] == std::numeric_limits<int64_t>::max());
+    CHECK( v[1] == std::numeric_limits<int64_t>::min());
+
+    // the fixed buffer keeps the first numbers, a long line is still not 2 coordinates
+    v = Util::ParseNumbers( "1,2,3,4,5,6,7,8,9,10", "," );
+    CHECK( v.size() == Util::Numbers::kCapacity );
+    CHECK( v[Util::Numbers::kCapacity - 1U] == 8 );
+    auto count = size_t{ 0 };
+    CHECK( Util::ForEachNumber( "1,2,3,4,5,6,7,8,9,10", ",", [&count]( const int64_t n ) {
+        count += static_cast<size_t>( n );
+        return true;
+    } ) == 10U );
+    CHECK( count == 55U );
 }
 
 /**
  * @brief Engine ParseInfo and parse line test
  */
 TEST_CASE( "Engine, ParseInfo", "[All]" ) {
-    Engine      e( 5 );
-    std::string rest;
+    Engine           e( 5 );
+    std::string      line;
+    std::string_view rest;
 
     e.AddCommandsToInputQueue( "info max_memory 123456" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
     CHECK( e.GetInfo().GetMaxMemory() == 123456 );
 
     e.AddCommandsToInputQueue( "info max_memory 0" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
     CHECK( e.GetInfo().GetMaxMemory() == kTTMemorySize );
 
     e.AddCommandsToInputQueue( "info TIMEOUT_MATCH 20000" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
     CHECK( e.GetInfo().GetTimeoutMatch() == 20000 );
 
     e.AddCommandsToInputQueue( "info TIMEOUT_TURN 20000" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
     CHECK( e.GetInfo().GetTimeoutTurn() == 20000 );
 
     e.AddCommandsToInputQueue( "info TIME_left 20000" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
     CHECK( e.GetInfo().GetTimeLeft() == 20000 );
 
     e.AddCommandsToInputQueue( "info hash_size 1024" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
 
     e.AddCommandsToInputQueue( "info max_node 9223372036854775807" );
-    CHECK( e.ParseCmd( e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
     e.CmdParseInfo( rest );
     CHECK( e.GetInfo().GetLimitNodes() == 9223372036854775807ULL );
 
+    e.AddCommandsToInputQueue( "info rule 6" );
+    CHECK( e.ParseCmd( line = e.ReadInputLine(), rest ) == Engine::eCommand::eInfo );
+    e.CmdParseInfo( rest );
+    CHECK( e.GetInfo().GetBoardRule() == eRuleRenju );
+    CHECK( e.GetInfo().GetContinuous() == 1 );
+
     /*
             "GAME_TYPE",
-            "RULE",
             "FOLDER",
     */
 }
@@ -181,6 +313,61 @@ TEST_CASE( "Engine, ParseYxBoard", "[All]" ) {
     CHECK( e.GetLastPipeOut().empty());
 }
 
+/**
+ * @brief Engine lists the forbidden moves of black in renju
+ */
+TEST_CASE( "Engine, ShowForbid", "[All]" ) {
+    Engine e( 15 );
+    CHECK( e.CmdExecute( "info rule 4" ));
+    CHECK( e.CmdExecute( "start 15" ));
+    CHECK( e.GetLastPipeOut() == "OK" );
+    e.AddCommandsToInputQueue( "5,7,1\n6,7,1\n7,5,1\n7,6,1\n0,14,2\n2,14,2\n4,14,2\n6,14,2\ndone" );
+    CHECK( e.CmdExecute( "yxboard" ));
+    CHECK( e.CmdExecute( "yxshowforbid" ));
+    CHECK( e.GetLastPipeOut() == "FORBID 0707." );
+
+    CHECK( e.CmdExecute( "restart" ));
+    CHECK( e.GetLastPipeOut() == "OK" );
+    CHECK( e.CmdExecute( "yxshowforbid" ));
+    CHECK( e.GetLastPipeOut() == "FORBID ." );
+}
+
+/**
+ * @brief Engine reports the winner of a finished game
+ */
+TEST_CASE( "Engine, Result", "[All]" ) {
+    Engine e( 15 );
+    CHECK( e.CmdExecute( "start 15" ));
+    CHECK( e.GetLastPipeOut() == "OK" );
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT NONE" );
+
+    // own stones started, the opponent made five
+    e.AddCommandsToInputQueue( "0,0,1\n0,5,2\n1,1,1\n1,5,2\n2,2,1\n2,5,2\n3,9,1\n3,5,2\n4,9,1\n4,5,2\ndone" );
+    CHECK( e.CmdExecute( "yxboard" ));
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT WHITE" );
+
+    // renju, the black double three loses
+    CHECK( e.CmdExecute( "info rule 4" ));
+    e.AddCommandsToInputQueue( "5,7,1\n0,14,2\n6,7,1\n2,14,2\n7,5,1\n4,14,2\n7,6,1\n6,14,2\n7,7,1\ndone" );
+    CHECK( e.CmdExecute( "yxboard" ));
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT WHITE" );
+    e.AddCommandsToInputQueue( "5,7,2\n0,14,1\n6,7,2\n2,14,1\n7,5,2\n4,14,1\n7,6,2\n6,14,1\n7,7,2\ndone" );
+    CHECK( e.CmdExecute( "yxboard" ));
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT WHITE" );
+    e.AddCommandsToInputQueue( "3,7,1\n0,14,2\n4,7,1\n2,14,2\n5,7,1\n4,14,2\n6,7,1\n6,14,2\n7,7,1\ndone" );
+    CHECK( e.CmdExecute( "yxboard" ));
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT BLACK" );
+    CHECK( e.CmdExecute( "restart" ));
+    CHECK( e.GetLastPipeOut() == "OK" );
+    CHECK( e.CmdExecute( "yxresult" ));
+    CHECK( e.GetLastPipeOut() == "MESSAGE RESULT NONE" );
+}
+
 /**
  * @brief Engine Execute test
  */
@@ -262,6 +449,42 @@ TEST_CASE( "Engine, CmdPutMove", "[All]" ) {
     CHECK( e.GetLastPipeOut() == "ERROR my move [5,5]" );
 }
 
+/**
+ * @brief Output lines read into one reused buffer, its previous buffer goes back to the engine
+ */
+TEST_CASE( "Engine, OutputBuffers", "[All]" ) {
+    Engine e( 5 );
+    e.CmdStart( 5 );
+    e.CmdPutMyMove( 7, 7 );
+    e.CmdAbout();
+
+    std::string line( "stale" );
+    CHECK( e.ReadFromOutputQueue( line, 1 ));
+    CHECK( line == "OK" );
+    CHECK( e.ReadFromOutputQueue( line, 1 ));
+    CHECK( line == "DEBUG check move [7,7]" );
+    CHECK( e.ReadFromOutputQueue( line, 1 ));
+    CHECK( line == "ERROR my move [7,7]" );
+    CHECK( e.ReadFromOutputQueue( line, 1 ));
+    CHECK_THAT( line, Catch::Matchers::Contains( "Generic" ));
+    CHECK( !e.ReadFromOutputQueue( line, 1 ));
+    CHECK( line.empty());
+
+    // more lines than buffers, the engine allocates and keeps what comes back
+    for( auto i = 0U; i < 100U; ++i ) {
+        e.CmdPutYourMove( i, 9U );
+    }
+    for( auto i = 0U; i < 200U; ++i ) {
+        REQUIRE( e.ReadFromOutputQueue( line, 1 ));
+        if( i % 2U == 1U ) {
+            CHECK( line == "ERROR opponent's move [" + std::to_string( i / 2U ) + ",9]" );
+        }
+    }
+    CHECK( e.IsEmptyOutputQueue());
+    CHECK( e.GetLastPipeOut() == "ERROR opponent's move [99,9]" );
+    CHECK( e.GetLastPipeOut().empty());
+}
+
 /**
  * @brief Engine RESTART command test
  */
@@ -281,3 +504,178 @@ TEST_CASE( "Engine, CmdRestart", "[All]" ) {
     CHECK( e.GetLastPipeOut() == "OK" );
     CHECK( e.GetBoard()->GetGamePly() == 0 );
 }
+
+/**
+ * @brief Caches, boards and queues together stay within INFO MAX_MEMORY
+ */
+TEST_CASE( "Engine, MemoryBudget", "[All]" ) {
+    Engine e( 20 );
+    CHECK( e.GetCacheSize() + e.GetReservedMemory() <= e.GetInfo().GetMaxMemory());
+
+    for( const auto threads : { "1", "4", "8" } ) {
+        e.CmdParseInfo( std::string( "THREAD_NUM " ) + threads );
+        for( const auto memory : { "1000000", "2000000", "5242880", "70000000" } ) {
+            e.CmdParseInfo( std::string( "MAX_MEMORY " ) + memory );
+            CHECK( e.GetCacheSize() + e.GetReservedMemory() <= e.GetInfo().GetMaxMemory());
+        }
+    }
+
+    // more threads leave less to the caches
+    e.CmdParseInfo( "MAX_MEMORY 2000000" );
+    const auto size = e.GetCacheSize();
+    e.CmdParseInfo( "THREAD_NUM 1" );
+    CHECK( e.GetCacheSize() >= size );
+    CHECK( e.GetCacheSize() + e.GetReservedMemory() <= e.GetInfo().GetMaxMemory());
+}
+
+/**
+ * @brief Engine threaded loop test, as used by the console brain
+ */
+TEST_CASE( "Engine, StartLoop", "[All]" ) {
+    Engine e( 20 );
+    CHECK( !e.IsLoopRunning());
+
+    e.StartLoop();
+    CHECK( e.IsLoopRunning());
+
+    e.AddCommandsToInputQueue( "start 15\nend" );
+    CHECK( e.ReadFromOutputQueue( 1000 ) == "OK" );
+    while( e.IsLoopRunning()) {
+        std::this_thread::yield();
+    }
+    CHECK( e.IsEmptyOutputQueue());
+}
+
+/**
+ * @brief Engine reads commands during the search, YXSTOP answers the best move so far
+ */
+TEST_CASE( "Engine, Stop", "[All]" ) {
+    Engine e( 20 );
+    e.StartLoop();
+
+    e.AddCommandsToInputQueue( "info TIMEOUT_TURN 60000\nstart 20" );
+    CHECK( e.ReadFromOutputQueue( 1000 ) == "OK" );
+    e.AddCommandsToInputQueue( "turn 10,10" );
+    while( !e.IsInSearch()) {
+        std::this_thread::yield();
+    }
+
+    const auto readUntil = [&e]( const std::string& text ) {
+        for( auto line = e.ReadFromOutputQueue( 1000 ); !line.empty(); line = e.ReadFromOutputQueue( 1000 )) {
+            if( line.find( text ) != std::string::npos && line.find( "DEPTH" ) == std::string::npos &&
+                line.find( "VCT" ) == std::string::npos ) {
+                return line;
+            }
+        }
+        return std::string{};
+    };
+
+    e.AddCommandsToInputQueue( "about" );
+    CHECK_THAT( readUntil( "IN SEARCH MODE" ), Catch::Matchers::Contains( "BAD COMMAND about" ));
+    CHECK( e.IsInSearch());
+
+    const auto start = std::chrono::steady_clock::now();
+    e.AddCommandsToInputQueue( "yxstop" );
+    CHECK_THAT( readUntil( "," ), !Catch::Matchers::Contains( "MESSAGE" ));
+    CHECK( std::chrono::steady_clock::now() - start < std::chrono::milliseconds( 500 ));
+    CHECK( e.GetBoard()->GetGamePly() == 2 );
+
+    e.AddCommandsToInputQueue( "end" );
+    while( e.IsLoopRunning()) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Engine leaves the search mode before its move is read, the next command is not refused
+ */
+TEST_CASE( "Engine, ReplyAfterMove", "[All]" ) {
+    Engine e( 20 );
+    e.StartLoop();
+
+    // the first line which is not a MESSAGE, a refused command times out
+    const auto readAnswer = [&e]() {
+        for( auto line = e.ReadFromOutputQueue( 2000 ); !line.empty(); line = e.ReadFromOutputQueue( 2000 )) {
+            if( line.rfind( "MESSAGE", 0 ) != 0 ) {
+                return line;
+            }
+        }
+        return std::string{};
+    };
+
+    e.AddCommandsToInputQueue( "info MAX_DEPTH 2\nstart 20" );
+    CHECK( readAnswer() == "OK" );
+
+    std::vector<std::string> moves;
+    for( auto x = 0; x < 20; x += 3 ) {
+        const auto cell = std::to_string( x ) + ",0";
+        if( std::find( moves.begin(), moves.end(), cell ) != moves.end()) {
+            continue;
+        }
+        // the reply goes out at once, as a manager sends it
+        e.AddCommandsToInputQueue( "turn " + cell );
+        const auto move = readAnswer();
+        CHECK( !e.IsInSearch());
+        REQUIRE_THAT( move, Catch::Matchers::Contains( "," ) && !Catch::Matchers::Contains( "ERROR" ));
+        moves.push_back( move );
+    }
+    CHECK( e.GetBoard()->GetGamePly() == 2U * moves.size());
+
+    e.AddCommandsToInputQueue( "end" );
+    while( e.IsLoopRunning()) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Engine searches the expected reply after its move, TURN reports hit or miss
+ */
+TEST_CASE( "Engine, Ponder", "[All]" ) {
+    Engine e( 20 );
+    e.StartLoop();
+
+    const auto readUntil = [&e]( const std::string& text ) {
+        for( auto line = e.ReadFromOutputQueue( 2000 ); !line.empty(); line = e.ReadFromOutputQueue( 2000 )) {
+            if( line.find( text ) != std::string::npos ) {
+                return line;
+            }
+        }
+        return std::string{};
+    };
+    const auto waitPonder = [&e]() {
+        for( auto i = 0; i < 1000 && e.IsInSearch(); ++i ) {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ));
+        }
+        return e.IsPondering();
+    };
+
+    e.AddCommandsToInputQueue( "info TIMEOUT_TURN 100\ninfo PONDER 1\nstart 20" );
+    CHECK( readUntil( "OK" ) == "OK" );
+    e.AddCommandsToInputQueue( "turn 10,10" );
+    CHECK( !readUntil( "," ).empty());
+    // pondering is set with the move, the reply sent at once stops it
+    CHECK( !e.IsInSearch());
+    REQUIRE( e.IsPondering());
+
+    // the expected reply
+    const auto reply = e.GetPonderMove();
+    e.AddCommandsToInputQueue( "turn " + std::to_string( GetX( reply )) + "," + std::to_string( GetY( reply )));
+    CHECK_THAT( readUntil( "PONDER" ), Catch::Matchers::Contains( "PONDER HIT" ));
+    CHECK( !readUntil( "," ).empty());
+    REQUIRE( waitPonder());
+
+    // another reply, the throttled engine does not ponder
+    e.AddCommandsToInputQueue( "info POWER_SAVE 1" );
+    while( e.IsPondering()) {
+        std::this_thread::yield();
+    }
+    e.AddCommandsToInputQueue( "turn 0,0" );
+    CHECK_THAT( readUntil( "PONDER" ), Catch::Matchers::Contains( "PONDER MISS" ));
+    CHECK( !readUntil( "," ).empty());
+    CHECK( !waitPonder());
+
+    e.AddCommandsToInputQueue( "end" );
+    while( e.IsLoopRunning()) {
+        std::this_thread::yield();
+    }
+}
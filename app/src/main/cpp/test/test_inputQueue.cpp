@@ -1,11 +1,14 @@
 /**
  * @file test_inputQueue.cpp
- * @brief Unit tests for LockedQueue
+ * @brief Unit tests for LockedQueue and SpscQueue
  **/
 #include "catch.hpp"
 
 #include "../brain/lockedQueue.h"
+#include "../brain/spscQueue.h"
+
 #include <future>
+#include <string>
 
 /**
  * @brief LockedQueue basic test
@@ -33,3 +36,79 @@ TEST_CASE( "LockedQueue, Basic", "[All]" ) {
     CHECK( f1.get() + f2.get() == 8 );
     CHECK( q.is_empty());
 }
+
+/**
+ * @brief SpscQueue keeps the order over the end of the ring, a pop without data times out
+ */
+TEST_CASE( "SpscQueue, Basic", "[All]" ) {
+    SpscQueue<std::string, 4> q;
+
+    CHECK( q.count() == 0 );
+    CHECK( q.is_empty());
+    CHECK( q.pop( 1 ).empty());
+
+    for( auto i = 0; i < 10; ++i ) {
+        q.push( std::to_string( i ));
+        q.push( std::to_string( i + 100 ));
+        CHECK( q.count() == 2 );
+        CHECK( q.pop( 0 ) == std::to_string( i ));
+        CHECK( q.pop( 0 ) == std::to_string( i + 100 ));
+    }
+    CHECK( q.is_empty());
+
+    q.push( "a" );
+    q.push( "b" );
+    q.clear();
+    CHECK( q.is_empty());
+}
+
+/**
+ * @brief SpscQueue consumer sleeps until the data come, a full ring stops the producer
+ */
+TEST_CASE( "SpscQueue, Threads", "[All]" ) {
+    SpscQueue<int, 8> q;
+
+    auto waiting = std::async( std::launch::async, [&q]() { return q.pop( 0 ); } );
+    q.push( 3 );
+    CHECK( waiting.get() == 3 );
+    auto timed = std::async( std::launch::async, [&q]() { return q.pop( 5000 ); } );
+    q.push( 5 );
+    CHECK( timed.get() == 5 );
+
+    constexpr auto kCount = 10000;
+    auto sum = std::async( std::launch::async, [&q]() {
+        auto total = 0LL;
+        for( auto i = 0; i < kCount; ++i ) {
+            total += q.pop( 0 );
+        }
+        return total;
+    } );
+    for( auto i = 1; i <= kCount; ++i ) {
+        q.push( i );
+    }
+    CHECK( sum.get() == static_cast<long long>( kCount ) * ( kCount + 1 ) / 2 );
+    CHECK( q.is_empty());
+}
+
+/**
+ * @brief SpscQueue full, try_push fails and push sleeps until the consumer frees a slot
+ */
+TEST_CASE( "SpscQueue, Full", "[All]" ) {
+    SpscQueue<int, 4> q;
+
+    for( auto i = 0; i < 4; ++i ) {
+        CHECK( q.try_push( int{ i } ));
+    }
+    auto item = 4;
+    CHECK( !q.try_push( std::move( item )));
+    CHECK( q.count() == 4 );
+
+    auto blocked = std::async( std::launch::async, [&q]() { q.push( 4 ); } );
+    CHECK( blocked.wait_for( std::chrono::milliseconds( 50 )) == std::future_status::timeout );
+    CHECK( q.pop( 0 ) == 0 );
+    blocked.get();
+    for( auto i = 1; i <= 4; ++i ) {
+        CHECK( q.pop( 0 ) == i );
+    }
+    CHECK( q.is_empty());
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_log.cpp
+ * @brief Log filters and the ring of the last messages
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/log.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Text of the ring
+     */
+    std::string Dump() {
+        std::vector<char> buffer( 64U * 1024U );
+        return std::string( buffer.data(), Log::Dump( buffer.data(), buffer.size()));
+    }
+
+    /**
+     * @brief Restore the run-time level at the end of a test
+     */
+    struct LevelGuard {
+        const int level = Log::GetLevel(); /**< level before the test */
+        ~LevelGuard() { Log::SetLevel( level ); }
+    };
+}
+
+/**
+ * @brief Filtered messages are neither evaluated nor recorded
+ */
+TEST_CASE( "Log, Level", "[All]" ) {
+    const LevelGuard guard;
+    Log::ClearRing();
+    Log::SetLevel( ANDROID_LOG_INFO );
+
+    auto calls = 0;
+    BRAIN_LOG( ANDROID_LOG_INFO, "Test", "turn ", 7, ',', 8, " depth ", ++calls, ' ', true, ' ', 0.5 );
+    CHECK( calls == 1 );
+    CHECK( Dump() == "I/Test: turn 7,8 depth 1 true 0.5\n" );
+
+    Log::SetLevel( ANDROID_LOG_ERROR );
+    BRAIN_LOG( ANDROID_LOG_INFO, "Test", ++calls );
+    CHECK( calls == 1 );
+    BRAIN_LOG( ANDROID_LOG_ERROR, "Test", std::string( "error " ) + "text" );
+    CHECK( Dump() == "I/Test: turn 7,8 depth 1 true 0.5\nE/Test: error text\n" );
+
+    // below the compiled level nothing is left, whatever the run-time level
+    Log::SetLevel( ANDROID_LOG_VERBOSE );
+    BRAIN_LOG( ANDROID_LOG_VERBOSE, "Test", ++calls );
+    CHECK( calls == ( Log::kCompileLevel <= ANDROID_LOG_VERBOSE ? 2 : 1 ));
+
+    Log::ClearRing();
+    CHECK( Dump().empty());
+}
+
+/**
+ * @brief Ring keeps the last messages, long texts and small buffers are cut
+ */
+TEST_CASE( "Log, Ring", "[All]" ) {
+    const LevelGuard guard;
+    Log::ClearRing();
+    Log::SetLevel( ANDROID_LOG_INFO );
+
+    for( auto i = 0; i < 200; ++i ) {
+        BRAIN_LOG( ANDROID_LOG_INFO, "Ring", i );
+    }
+    const auto text = Dump();
+    CHECK( text.find( "I/Ring: 135\n" ) == std::string::npos );
+    CHECK( text.find( "I/Ring: 136\n" ) == 0U );
+    CHECK( text.size() >= std::string( "I/Ring: 199\n" ).size());
+    CHECK( text.substr( text.size() - 12U ) == "I/Ring: 199\n" );
+
+    // whole lines only
+    char small[20];
+    CHECK( Log::Dump( small, sizeof( small )) == 12U );
+    CHECK( std::string( small, 12U ) == "I/Ring: 136\n" );
+
+    Log::ClearRing();
+    BRAIN_LOG( ANDROID_LOG_INFO, "Long", std::string( 1000U, 'x' ));
+    const auto line = Dump();
+    CHECK( line.size() < 200U );
+    CHECK( line.rfind( "I/Long: xxx", 0 ) == 0U );
+    CHECK( line.back() == '\n' );
+
+    // concurrent writers, every dumped line is whole
+    Log::ClearRing();
+    std::vector<std::thread> writers;
+    for( auto t = 0; t < 4; ++t ) {
+        writers.emplace_back( [t]() {
+            for( auto i = 0; i < 1000; ++i ) {
+                BRAIN_LOG( ANDROID_LOG_INFO, "Thread", t, ':', i );
+            }
+        } );
+    }
+    auto dumps = 0U;
+    while( dumps < 100U ) {
+        const auto lines = Dump();
+        for( size_t pos = 0U, end = 0U; ( end = lines.find( '\n', pos )) != std::string::npos; pos = end + 1U ) {
+            CHECK( lines.compare( pos, 9U, "I/Thread:" ) == 0 );
+        }
+        ++dumps;
+    }
+    for( auto& w : writers ) {
+        w.join();
+    }
+    CHECK( Dump().find( "I/Thread: " ) == 0U );
+    Log::ClearRing();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file test_openingBook.cpp
+ * @brief Opening book tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/board.h"
+#include "../brain/engine.h"
+#include "../brain/openingBook.h"
+
+#include <cstdlib>
+#include <sys/stat.h>
+
+namespace {
+    /**
+     * @brief Writable folder of the test books, upper case letters check the path handling
+     */
+    std::string BookFolder() {
+        const auto* const tmp    = std::getenv( "TMPDIR" );
+        const auto        folder = std::string( tmp != nullptr ? tmp : "/tmp" ) + "/GomokuBook";
+        mkdir( folder.c_str(), 0700 );
+        return folder;
+    }
+
+    /**
+     * @brief Book of one line, 7,7 8,8 8,6 and a less played 7,7 6,7
+     */
+    bool SaveBook( const std::string& path, const eRule rule ) {
+        std::vector<OpeningBook::Entry> entries;
+        const auto add = [&entries]( const std::vector<Move>& moves ) {
+            Board board( 15 );
+            for( const auto m : moves ) {
+                entries.push_back( OpeningBook::MakeEntry( board, GetX( m ), GetY( m ), 1U ));
+                board.MakeMove( SetType( m, board.SideToMove() ? eMove_t::eXX : eMove_t::eOO ));
+            }
+        };
+        add( { SetCoords( 7, 7 ), SetCoords( 8, 8 ), SetCoords( 8, 6 ) } );
+        add( { SetCoords( 7, 7 ), SetCoords( 8, 8 ), SetCoords( 8, 6 ) } );
+        add( { SetCoords( 7, 7 ), SetCoords( 6, 7 ) } );
+        return OpeningBook::Save( path, 15U, rule, entries );
+    }
+}
+
+/**
+ * @brief Book moves of any orientation, the book must match the board and the rule
+ */
+TEST_CASE( "OpeningBook, Probe", "[All]" ) {
+    const auto path = BookFolder() + "/" + OpeningBook::kFileName;
+    if( !SaveBook( path, eRuleFreestyle )) {
+        WARN( "no writable folder for the book" );
+        return;
+    }
+
+    OpeningBook book;
+    CHECK( !book.Open( path + ".missing" ));
+    REQUIRE( book.Open( path ));
+    CHECK( book.IsOpen());
+    CHECK( book.GetCount() == 4U );
+
+    // the more played reply
+    Board b( 15 );
+    b.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    b.SetSideToMove( true );
+    CHECK( book.Probe( b ) == createMove<eMove_t::eXX>( 8, 8 ));
+
+    // the line rotated by 180 degrees, the diagonal mirror is the same position
+    b.MakeMove( createMove<eMove_t::eXX>( 6, 6 ));
+    const auto reply = book.Probe( b );
+    CHECK(( reply == createMove<eMove_t::eOO>( 6, 8 ) || reply == createMove<eMove_t::eOO>( 8, 6 )));
+    b.MakeMove( reply );
+    CHECK( !IsOk( book.Probe( b )));
+
+    // black to move after an even count of stones only
+    Board c( 15 );
+    c.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    c.SetSideToMove( false );
+    CHECK( !IsOk( book.Probe( c )));
+
+    Board other( 20 );
+    other.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    other.SetSideToMove( true );
+    CHECK( !IsOk( book.Probe( other )));
+
+    Board renju( 15 );
+    renju.SetRule( eRuleRenju );
+    renju.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    renju.SetSideToMove( true );
+    CHECK( !IsOk( book.Probe( renju )));
+
+    book.Close();
+    CHECK( !book.IsOpen());
+    CHECK( !IsOk( book.Probe( b )));
+}
+
+/**
+ * @brief Engine plays the book move of INFO FOLDER without a search
+ */
+TEST_CASE( "OpeningBook, Engine", "[All]" ) {
+    const auto folder = BookFolder();
+    if( !SaveBook( folder + "/" + OpeningBook::kFileName, eRuleFreestyle )) {
+        WARN( "no writable folder for the book" );
+        return;
+    }
+
+    Engine e( 15 );
+    e.AddCommandsToInputQueue( "info folder " + folder + "\ninfo usedatabase 1\nstart 15\nturn 7,7\nend" );
+    e.Loop();
+    CHECK( e.GetInfo().GetFolder() == folder );
+    CHECK( e.GetBook().IsOpen());
+
+    auto book = false;
+    auto move = std::string{};
+    while( !e.IsEmptyOutputQueue()) {
+        const auto line = e.ReadFromOutputQueue( 1 );
+        book = book || line == "MESSAGE BOOK";
+        move = line;
+    }
+    CHECK( book );
+    CHECK( move == "8,8" );
+
+    CHECK( e.CmdExecute( "INFO USEDATABASE 0" ));
+    CHECK( !e.GetBook().IsOpen());
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_search.cpp
+ * @brief Search tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/board.h"
+#include "../brain/lazySmp.h"
+#include "../brain/search.h"
+#include "../brain/transpositionTable.h"
+
+/**
+ * @brief Search on empty board, centre expected
+ */
+TEST_CASE( "Search, EmptyBoard", "[All]" ) {
+    Board              b( 15 );
+    TranspositionTable tt( kTTMemorySize );
+    Search             s( b, tt );
+
+    const auto m = s.Think( SearchLimits{ 4, 0, 0 } );
+    CHECK( m == createMove<eMove_t::eXX>( 7, 7 ));
+    CHECK( b.GetGamePly() == 0 );
+}
+
+/**
+ * @brief Search completes own four
+ */
+TEST_CASE( "Search, WinInOne", "[All]" ) {
+    Board              b( 15 );
+    TranspositionTable tt( kTTMemorySize );
+    for( coord_t x = 3; x < 7; ++x ) {
+        b.MakeMove( createMove<eMove_t::eXX>( x, 5 ));
+        b.MakeMove( createMove<eMove_t::eOO>( x + 1, 9 ));
+    }
+    b.MakeMove( createMove<eMove_t::eXX>( 2, 4 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 2, 5 ));
+
+    Search     s( b, tt );
+    const auto m = s.Think( SearchLimits{ 4, 0, 0 } );
+    CHECK( m == createMove<eMove_t::eXX>( 7, 5 ));
+    CHECK( s.GetInfo().score == kScoreWin - 1 );
+    CHECK( b.GetGamePly() == 10 );
+}
+
+/**
+ * @brief Search blocks opponent's four, plays open four instead of slower moves
+ */
+TEST_CASE( "Search, Defend", "[All]" ) {
+    Board              b( 15 );
+    TranspositionTable tt( kTTMemorySize );
+    b.MakeMove( createMove<eMove_t::eXX>( 0, 0 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 5, 5 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 0, 14 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 6, 6 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 4, 4 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 7, 7 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 14, 0 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+
+    Search s( b, tt );
+    CHECK( s.Think( SearchLimits{ 4, 0, 0 } ) == createMove<eMove_t::eXX>( 9, 9 ));
+
+    b.MakeMove( createMove<eMove_t::eXX>( 9, 9 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 14, 14 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 9, 4 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 10, 4 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 9, 5 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 10, 5 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 9, 6 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 14, 13 ));
+
+    // open three of eXX is preferred, it wins
+    const auto m = s.Think( SearchLimits{ 4, 0, 0 } );
+    CHECK(( m == createMove<eMove_t::eXX>( 9, 7 ) || m == createMove<eMove_t::eXX>( 9, 3 )));
+    CHECK( s.GetInfo().score >= kScoreWinMin );
+}
+
+/**
+ * @brief Renju, a five of eOO on a cell forbidden to black cannot be blocked
+ */
+TEST_CASE( "Search, ForbiddenBlock", "[All]" ) {
+    Board              b( 15 );
+    TranspositionTable tt( kTTMemorySize );
+    b.SetRule( eRuleRenju );
+    // double three of black at 7,7, the four of eOO ends there
+    b.MakeMove( createMove<eMove_t::eXX>( 5, 7 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 3, 3 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 6, 7 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 4, 4 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 5 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 5, 5 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 6 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 6, 6 ));
+    b.MakeMove( createMove<eMove_t::eXX>( 2, 2 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 0, 14 ));
+    REQUIRE( b.IsForbidden( eMove_t::eXX, 7, 7 ));
+
+    // the static evaluation already knows the loss
+    Search     s( b, tt );
+    const auto m = s.Think( SearchLimits{ 4, 0, 0 } );
+    CHECK( IsOk( m ));
+    CHECK( !b.IsForbidden( eMove_t::eXX, GetX( m ), GetY( m )));
+    CHECK( s.GetInfo().score == -( kScoreWin - 2 ));
+    CHECK( s.GetInfo().depth == 0U );
+    CHECK( b.GetGamePly() == 10 );
+}
+
+/**
+ * @brief Search honours node and depth limits
+ */
+TEST_CASE( "Search, Limits", "[All]" ) {
+    Board              b( 20 );
+    TranspositionTable tt( kTTMemorySize );
+    b.MakeMove( createMove<eMove_t::eXX>( 10, 10 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 11, 11 ));
+
+    Search s( b, tt );
+    CHECK( IsOk( s.Think( SearchLimits{ 3, 0, 0 } )));
+    CHECK( s.GetInfo().depth == 3 );
+
+    CHECK( IsOk( s.Think( SearchLimits{ 0, 2000, 0 } )));
+    CHECK( s.GetInfo().nodes <= 2000 + 1024 );
+    CHECK( b.GetGamePly() == 2 );
+}
+
+/**
+ * @brief Parallel search finds the same win, board of the main thread is restored
+ */
+TEST_CASE( "Search, Threads", "[All]" ) {
+    Board              b( 20 );
+    TranspositionTable tt( kTTMemorySize );
+    for( coord_t x = 3; x < 7; ++x ) {
+        b.MakeMove( createMove<eMove_t::eXX>( x, 5 ));
+        b.MakeMove( createMove<eMove_t::eOO>( x + 1, 9 ));
+    }
+    b.MakeMove( createMove<eMove_t::eXX>( 2, 4 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 2, 5 ));
+
+    LazySmp smp( b, tt, 4 );
+    CHECK( smp.Think( SearchLimits{ 4, 0, 0 } ) == createMove<eMove_t::eXX>( 7, 5 ));
+    CHECK( smp.GetInfo().score == kScoreWin - 1 );
+    CHECK( b.GetGamePly() == 10 );
+
+    // node limit counts all threads
+    b.MakeMove( createMove<eMove_t::eXX>( 12, 12 ));
+    CHECK( IsOk( smp.Think( SearchLimits{ 0, 3000, 0 } )));
+    CHECK( smp.GetInfo().nodes <= 3000 + 4 * 1024 );
+    CHECK( b.GetGamePly() == 11 );
+}
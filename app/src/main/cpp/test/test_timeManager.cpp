@@ -0,0 +1,105 @@
+/**
+ * @file test_timeManager.cpp
+ * @brief Turn time budget tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/config.h"
+#include "../brain/timeManager.h"
+
+/**
+ * @brief Turn limit only, the protocol reserve is kept
+ */
+TEST_CASE( "TimeManager, Turn", "[All]" ) {
+    Config c;
+    {
+        const TimeManager t( c, 0 );
+        CHECK( t.GetHardMs() == kDefaultTimeoutTurn - kMoveOverheadMs );
+        CHECK( t.GetSoftMs() == t.GetHardMs() / 2 );
+    }
+    c.SetTimeoutTurn( 5000 );
+    {
+        const TimeManager t( c, 100 );
+        CHECK( t.GetHardMs() == 5000 - kMoveOverheadMs );
+        CHECK( t.GetSoftMs() == t.GetHardMs() / 2 );
+        CHECK( t.RemainingHardMs() <= t.GetHardMs());
+        CHECK( t.RemainingSoftMs() >= 1 );
+    }
+    c.SetTimeoutTurn( 10 );
+    {
+        const TimeManager t( c, 0 );
+        CHECK( t.GetHardMs() == 5 );
+        CHECK( t.GetSoftMs() == 2 );
+    }
+
+    // TIMEOUT_TURN 0 is as fast as possible, not the default
+    CHECK( !Config().IsTimeoutTurnSet());
+    c.SetTimeoutTurn( 0 );
+    CHECK( c.IsTimeoutTurnSet());
+    {
+        const TimeManager t( c, 100 );
+        CHECK( t.GetHardMs() == kMoveOverheadMs );
+        CHECK( t.GetSoftMs() == 1 );
+    }
+    c.SetTimeoutMatch( 180000 );
+    {
+        const TimeManager t( c, 100 );
+        CHECK( t.GetHardMs() == kMoveOverheadMs );
+        CHECK( t.GetSoftMs() == 1 );
+    }
+}
+
+/**
+ * @brief Match time is split among the remaining moves
+ */
+TEST_CASE( "TimeManager, Match", "[All]" ) {
+    Config c;
+    c.SetTimeoutTurn( 30000 ).SetTimeoutMatch( 180000 );
+    {
+        // time left not known yet
+        const TimeManager t( c, 0 );
+        CHECK( t.GetSoftMs() == ( 180000 - kMoveOverheadMs ) / TimeManager::kExpectedMoves );
+        CHECK( t.GetHardMs() == 30000 - kMoveOverheadMs );
+    }
+    c.SetTimeLeft( 60000 );
+    {
+        const TimeManager t( c, 200 );
+        CHECK( t.GetSoftMs() == ( 60000 - kMoveOverheadMs ) / TimeManager::kMinMovesToGo );
+        CHECK( t.GetHardMs() == ( 60000 - kMoveOverheadMs ) / TimeManager::kHardShare );
+    }
+    c.SetTimeInc( 1000 );
+    {
+        const TimeManager t( c, 200 );
+        CHECK( t.GetSoftMs() == ( 60000 - kMoveOverheadMs ) / TimeManager::kMinMovesToGo + 500 );
+    }
+
+    // nearly lost on time, still a limit
+    c.SetTimeLeft( 3 ).SetTimeInc( 0 );
+    {
+        const TimeManager t( c, 200 );
+        CHECK( t.GetHardMs() == 1 );
+        CHECK( t.GetSoftMs() == 1 );
+    }
+}
+
+/**
+ * @brief Soft limit grows with best move changes, never above the hard one
+ */
+TEST_CASE( "TimeManager, Instability", "[All]" ) {
+    CHECK( TimeManager::ExtendSoft( 100, 1000, 0 ) == 100 );
+    CHECK( TimeManager::ExtendSoft( 100, 1000, TimeManager::kUnstableScale ) == 200 );
+    CHECK( TimeManager::ExtendSoft( 600, 1000, TimeManager::kUnstableScale ) == 1000 );
+
+    auto instability = 0U;
+    instability      = TimeManager::NextInstability( instability, true );
+    CHECK( instability == TimeManager::kUnstableStep );
+    for( auto i = 0; i < 10; ++i ) {
+        instability = TimeManager::NextInstability( instability, true );
+    }
+    CHECK( instability <= TimeManager::kUnstableMax );
+    for( auto i = 0; i < 10; ++i ) {
+        instability = TimeManager::NextInstability( instability, false );
+    }
+    CHECK( instability == 0 );
+}
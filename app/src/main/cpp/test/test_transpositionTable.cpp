@@ -0,0 +1,103 @@
+/**
+ * @file test_transpositionTable.cpp
+ * @brief Transposition table tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/engine.h"
+#include "../brain/transpositionTable.h"
+
+/**
+ * @brief Table size follows the memory budget
+ */
+TEST_CASE( "TranspositionTable, Resize", "[All]" ) {
+    TranspositionTable tt( kTTMemorySize );
+    CHECK( tt.GetSize() <= kTTMemorySize / TranspositionTable::kMemoryShare );
+    CHECK( tt.GetSize() * 2 > kTTMemorySize / TranspositionTable::kMemoryShare );
+    CHECK(( tt.GetSize() & ( tt.GetSize() - 1 )) == 0 );
+
+    tt.Resize( 1000000 );
+    CHECK( tt.GetSize() == 262144 );
+
+    Engine e( 20 );
+    CHECK( e.GetHashTable().GetSize() == TranspositionTable( kTTMemorySize ).GetSize());
+    e.CmdParseInfo( "MAX_MEMORY 70000000" );
+    CHECK( e.GetHashTable().GetSize() == 33554432 );
+    e.CmdParseInfo( "MAX_MEMORY 0" );
+    CHECK( e.GetHashTable().GetSize() <= kTTMemorySize );
+}
+
+/**
+ * @brief Store and probe entries
+ */
+TEST_CASE( "TranspositionTable, StoreProbe", "[All]" ) {
+    TranspositionTable tt( 1024 );
+    auto               e = TTEntry{};
+
+    CHECK( !tt.Probe( 12345, e ));
+
+    auto in    = TTEntry{};
+    in.score   = -29990;
+    in.depth   = 12;
+    in.bound   = eBoundLower;
+    in.hasMove = true;
+    in.x       = 19;
+    in.y       = 3;
+    tt.Store( 12345, in );
+
+    REQUIRE( tt.Probe( 12345, e ));
+    CHECK( e.score == in.score );
+    CHECK( e.depth == in.depth );
+    CHECK( e.bound == in.bound );
+    CHECK( e.hasMove );
+    CHECK( e.x == 19 );
+    CHECK( e.y == 3 );
+
+    // the move is kept if the new entry has none
+    in.hasMove = false;
+    in.depth   = 13;
+    tt.Store( 12345, in );
+    REQUIRE( tt.Probe( 12345, e ));
+    CHECK( e.depth == 13 );
+    CHECK( e.hasMove );
+    CHECK( e.x == 19 );
+
+    tt.Clear();
+    CHECK( !tt.Probe( 12345, e ));
+}
+
+/**
+ * @brief Old and shallow entries are replaced first
+ */
+TEST_CASE( "TranspositionTable, Replace", "[All]" ) {
+    TranspositionTable tt( 128 ); // one bucket
+    auto               in = TTEntry{};
+    in.bound = eBoundExact;
+
+    for( uint64_t key = 1; key <= TranspositionTable::kBucketEntries; ++key ) {
+        in.depth = static_cast<uint8_t>( 10 + key );
+        tt.Store( key, in );
+    }
+
+    // the shallowest entry goes first
+    in.depth = 1;
+    tt.Store( 100, in );
+    auto e = TTEntry{};
+    CHECK( !tt.Probe( 1, e ));
+    CHECK( tt.Probe( 100, e ));
+
+    // the next searches prefer replacing the old entries, a probe refreshes the age
+    tt.NewSearch();
+    tt.NewSearch();
+    CHECK( tt.Probe( 4, e ));
+    in.depth = 2;
+    tt.Store( 200, in );
+    tt.Store( 300, in );
+    CHECK( !tt.Probe( 100, e ));
+    CHECK( !tt.Probe( 2, e ));
+    CHECK( tt.Probe( 3, e ));
+    CHECK( tt.Probe( 4, e ));
+    CHECK( tt.Probe( 200, e ));
+    CHECK( tt.Probe( 300, e ));
+}
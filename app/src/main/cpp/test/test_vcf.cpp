@@ -0,0 +1,119 @@
+/**
+ * @file test_vcf.cpp
+ * @brief Continuous fours solver tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/board.h"
+#include "../brain/vcf.h"
+
+namespace {
+    /**
+     * @brief eXX wins by a diagonal four followed by a double four at 6,7
+     */
+    void SetupVcf( Board& b ) {
+        for( coord_t x = 3; x < 6; x++ ) {
+            b.MakeMove( createMove<eMove_t::eXX>( x, 7 ));
+        }
+        b.MakeMove( createMove<eMove_t::eOO>( 2, 7 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 6, 8 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 6, 9 ));
+        b.MakeMove( createMove<eMove_t::eOO>( 6, 11 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 7, 11 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 8, 12 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 9, 13 ));
+        b.MakeMove( createMove<eMove_t::eOO>( 10, 14 ));
+        b.SetSideToMove( true );
+    }
+}
+
+/**
+ * @brief No fours, no win
+ */
+TEST_CASE( "Vcf, NoWin", "[All]" ) {
+    Board b( 15 );
+    Vcf   vcf;
+    CHECK( !IsOk( vcf.Solve( b, 0 )));
+
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+    CHECK( !IsOk( vcf.Solve( b, 0 )));
+    CHECK( b.GetGamePly() == 2 );
+}
+
+/**
+ * @brief Five in one, then a longer sequence of fours
+ */
+TEST_CASE( "Vcf, Win", "[All]" ) {
+    Board b( 15 );
+    Vcf   vcf;
+    for( coord_t y = 3; y < 7; y++ ) {
+        b.MakeMove( createMove<eMove_t::eXX>( 1, y ));
+    }
+    b.MakeMove( createMove<eMove_t::eOO>( 1, 2 ));
+    b.SetSideToMove( true );
+    CHECK( vcf.Solve( b, 0 ) == createMove<eMove_t::eXX>( 1, 7 ));
+
+    b.Reset();
+    SetupVcf( b );
+    const auto key = b.GetKey();
+    const auto m   = vcf.Solve( b, 0 );
+    REQUIRE( IsOk( m ));
+    CHECK( GetType( m ) == eMove_t::eXX );
+    CHECK( b.GetKey() == key );
+    CHECK( vcf.GetNodes() > 1 );
+
+    // proven positions are cached
+    CHECK( vcf.Solve( b, 0 ) == m );
+    CHECK( vcf.GetNodes() == 1 );
+
+    // the defender has no fours at all
+    b.SetSideToMove( false );
+    CHECK( !IsOk( vcf.Solve( b, 0 )));
+}
+
+/**
+ * @brief A four of the defender has to be blocked first
+ */
+TEST_CASE( "Vcf, Defence", "[All]" ) {
+    Board b( 15 );
+    Vcf   vcf;
+    SetupVcf( b );
+    for( coord_t x = 0; x < 4; x++ ) {
+        b.MakeMove( createMove<eMove_t::eOO>( x, 0 ));
+    }
+    b.SetSideToMove( true );
+    CHECK( !IsOk( vcf.Solve( b, 0 )));
+}
+
+/**
+ * @brief Node limit stops the search
+ */
+TEST_CASE( "Vcf, Limits", "[All]" ) {
+    Board b( 15 );
+    Vcf   vcf;
+    SetupVcf( b );
+    CHECK( !IsOk( vcf.Solve( b, 1 )));
+    CHECK( vcf.GetNodes() == 1 );
+    CHECK( IsOk( vcf.Solve( b, 0 )));
+}
+
+/**
+ * @brief Cache size follows the memory budget, a small cache still proves the win
+ */
+TEST_CASE( "Vcf, Resize", "[All]" ) {
+    Vcf vcf( kTTMemorySize );
+    CHECK( vcf.GetSize() <= kTTMemorySize / Vcf::kMemoryShare );
+    CHECK( vcf.GetSize() * 2U > kTTMemorySize / Vcf::kMemoryShare );
+
+    vcf.Resize( 1000000U );
+    CHECK( vcf.GetSize() <= 1000000U / Vcf::kMemoryShare );
+    CHECK( Vcf().GetSize() == Vcf( 1U << 30U ).GetSize());
+
+    vcf.Resize( 0U );
+    CHECK( vcf.GetSize() > 0U );
+    Board b( 15 );
+    SetupVcf( b );
+    CHECK( IsOk( vcf.Solve( b, 0 )));
+}
@@ -0,0 +1,106 @@
+/**
+ * @file test_vct.cpp
+ * @brief Continuous threats solver tests
+ **/
+
+#include "catch.hpp"
+
+#include "../brain/board.h"
+#include "../brain/vcf.h"
+#include "../brain/vct.h"
+
+namespace {
+    /**
+     * @brief eXX wins by a double open three at 9,7, there is no four
+     */
+    void SetupVct( Board& b ) {
+        b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 8, 7 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 9, 8 ));
+        b.MakeMove( createMove<eMove_t::eXX>( 9, 9 ));
+        b.MakeMove( createMove<eMove_t::eOO>( 2, 2 ));
+        b.MakeMove( createMove<eMove_t::eOO>( 12, 12 ));
+        b.SetSideToMove( true );
+    }
+}
+
+/**
+ * @brief Table size follows the memory budget
+ */
+TEST_CASE( "Vct, Resize", "[All]" ) {
+    Vct vct( kTTMemorySize );
+    CHECK( vct.GetSize() <= kTTMemorySize / Vct::kMemoryShare );
+    CHECK( vct.GetSize() * 2U > kTTMemorySize / Vct::kMemoryShare );
+
+    vct.Resize( 4U * kTTMemorySize );
+    CHECK( vct.GetSize() <= kTTMemorySize );
+    vct.Resize( 0U );
+    CHECK( vct.GetSize() > 0U );
+}
+
+/**
+ * @brief No threats, no win
+ */
+TEST_CASE( "Vct, NoWin", "[All]" ) {
+    Board b( 15 );
+    Vct   vct( kTTMemorySize );
+    CHECK( !IsOk( vct.Solve( b, 0 )));
+
+    b.MakeMove( createMove<eMove_t::eXX>( 7, 7 ));
+    b.MakeMove( createMove<eMove_t::eOO>( 8, 8 ));
+    b.SetSideToMove( true );
+    CHECK( !IsOk( vct.Solve( b, 0 )));
+    CHECK( vct.GetMainLine().empty());
+    CHECK( b.GetGamePly() == 2 );
+}
+
+/**
+ * @brief Double open three, found by VCT only
+ */
+TEST_CASE( "Vct, Win", "[All]" ) {
+    Board b( 15 );
+    Vct   vct( kTTMemorySize );
+    Vcf   vcf;
+    SetupVct( b );
+    const auto key = b.GetKey();
+
+    CHECK( !IsOk( vcf.Solve( b, 0 )));
+    const auto m = vct.Solve( b, 0 );
+    REQUIRE( IsOk( m ));
+    CHECK( m == createMove<eMove_t::eXX>( 9, 7 ));
+    CHECK( b.GetKey() == key );
+
+    // attacker, defender, ... ending with a five or an unstoppable four of the attacker
+    const auto& line = vct.GetMainLine();
+    REQUIRE( line.size() >= 5U );
+    CHECK( line.front() == m );
+    CHECK( line.size() % 2U == 1U );
+    CHECK( GetType( line[1] ) == eMove_t::eOO );
+    CHECK( GetType( line.back()) == eMove_t::eXX );
+
+    for( const auto lm : line ) {
+        b.MakeMove( lm );
+    }
+    Move cells[2];
+    CHECK(( b.IsLastMoveFive() || Vcf::FiveCells( b, eMove_t::eXX, cells ) >= 2U ));
+}
+
+/**
+ * @brief A four of the defender has to be blocked first
+ */
+TEST_CASE( "Vct, Defence", "[All]" ) {
+    Board b( 15 );
+    Vct   vct( kTTMemorySize );
+    SetupVct( b );
+    for( coord_t y = 0; y < 4; y++ ) {
+        b.MakeMove( createMove<eMove_t::eOO>( 14, y ));
+    }
+    b.SetSideToMove( true );
+    CHECK( !IsOk( vct.Solve( b, 0 )));
+
+    // the defender has no threats at all
+    Board c( 15 );
+    SetupVct( c );
+    c.SetSideToMove( false );
+    CHECK( !IsOk( vct.Solve( c, 0 )));
+}
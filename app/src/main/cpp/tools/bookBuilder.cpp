@@ -0,0 +1,107 @@
+/**
+ * @file bookBuilder.cpp
+ * @brief Compile text opening lines into the binary book read by OpeningBook
+ *
+ * Usage: book-builder size rule lines.txt gomoku.book
+ * Every line of the input is one opening, moves are x,y pairs separated by spaces and
+ * black moves first, e.g. "7,7 8,8 8,6". Every position of a line gets its next move,
+ * lines sharing a position make the move heavier. Empty lines and lines starting with # are skipped.
+ **/
+
+#include "../brain/board.h"
+#include "../brain/openingBook.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Add the positions of one line to the book
+     * @param line x,y pairs
+     * @param size board size
+     * @param entries book moves, appended
+     * @return false if the line is not valid, nothing is added then
+     */
+    bool AddLine( const std::string& line, const coord_t size, std::vector<OpeningBook::Entry>& entries ) {
+        std::vector<int64_t> numbers;
+        Util::ForEachNumber( line, " ,\t", [&numbers]( const int64_t value ) {
+            numbers.push_back( value );
+            return true;
+        } );
+        if( numbers.empty() || numbers.size() % 2U != 0U ) {
+            return false;
+        }
+
+        std::vector<Move> moves;
+        for( size_t i = 0U; i < numbers.size(); i += 2U ) {
+            if( numbers[i] < 0 || numbers[i] >= size || numbers[i + 1U] < 0 || numbers[i + 1U] >= size ) {
+                return false;
+            }
+            const auto m = SetCoords( static_cast<coord_t>( numbers[i] ), static_cast<coord_t>( numbers[i + 1U] ));
+            for( const auto played : moves ) {
+                if( played == m ) {
+                    return false;
+                }
+            }
+            moves.push_back( m );
+        }
+
+        // black is eXX, the colours alternate
+        Board board( size );
+        for( const auto m : moves ) {
+            entries.push_back( OpeningBook::MakeEntry( board, GetX( m ), GetY( m ), 1U ));
+            board.MakeMove( SetType( m, board.SideToMove() ? eMove_t::eXX : eMove_t::eOO ));
+        }
+        return true;
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    const std::vector<std::string> args( argv, argv + argc );
+    if( args.size() != 5U ) {
+        std::cerr << "usage: book-builder size rule lines.txt " << OpeningBook::kFileName << "\n"
+                  << "  size  board size, 5.." << kPlaySize << "\n"
+                  << "  rule  0 freestyle, 1 exact five, 4 renju\n";
+        return 1;
+    }
+
+    const auto size = std::stoul( args[1] );
+    const auto rule = std::stoul( args[2] );
+    if( size < 5U || size > kPlaySize || ( rule != eRuleFreestyle && rule != eRuleExactFive && rule != eRuleRenju )) {
+        std::cerr << "bad size or rule\n";
+        return 1;
+    }
+
+    std::ifstream input( args[3] );
+    if( !input ) {
+        std::cerr << "cannot read " << args[3] << "\n";
+        return 1;
+    }
+
+    std::vector<OpeningBook::Entry> entries;
+    std::string                     line;
+    auto                            lineNumber = 0U;
+    auto                            lines      = 0U;
+    while( std::getline( input, line )) {
+        ++lineNumber;
+        line = Util::Trim( line );
+        if( line.empty() || line[0] == '#' ) {
+            continue;
+        }
+        if( AddLine( line, static_cast<coord_t>( size ), entries )) {
+            ++lines;
+        } else {
+            std::cerr << args[3] << ":" << lineNumber << ": bad line skipped\n";
+        }
+    }
+
+    if( !OpeningBook::Save( args[4], static_cast<coord_t>( size ), static_cast<eRule>( rule ), entries )) {
+        std::cerr << "cannot write " << args[4] << "\n";
+        return 1;
+    }
+    std::cout << lines << " lines, " << entries.size() << " book moves written to " << args[4] << "\n";
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file parseBench.cpp
+ * @brief Protocol line costs and heap allocations, parsing of commands and formatting of responses
+ *
+ * Usage: parse-bench [lines]
+ * - both command parsers read the same lines, 1M by default, the former keyword vector upper cases
+ *   each line first like CmdExecute() did
+ * - responses with numbers go through pipeOut() and the output queue to a reader reusing its buffer,
+ *   the former stringstream formatting is emulated for comparison
+ **/
+
+#include "../brain/engine.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    std::atomic<uint64_t> gAllocations{ 0U }; /**< operator new calls */
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief ParseCmd() before the hash table, a vector of keywords built per call
+     */
+    Engine::eCommand VectorParseCmd( const std::string& s, std::string& rest ) {
+        rest                 = "";
+        using eCommandVector = std::vector<std::pair<std::string, Engine::eCommand>>;
+        const auto keywords  = eCommandVector{{ "ABOUT",        Engine::eCommand::eAbout },
+                                              { "BEGIN",        Engine::eCommand::eBegin },
+                                              { "END",          Engine::eCommand::eEnd },
+                                              { "TURN",         Engine::eCommand::eTurn },
+                                              { "TAKEBACK",     Engine::eCommand::eTakeback },
+                                              { "BOARD",        Engine::eCommand::eBoard },
+                                              { "PLAY",         Engine::eCommand::ePlay },
+                                              { "START",        Engine::eCommand::eStart },
+                                              { "RESTART",      Engine::eCommand::eRestart },
+                                              { "INFO",         Engine::eCommand::eInfo },
+                                              { "YXBOARD",      Engine::eCommand::eYxBoard },
+                                              { "YXRESULT",     Engine::eCommand::eAnResult },
+                                              { "YXSHOWFORBID", Engine::eCommand::eYxShowForbid },
+                                              { "YXSTOP",       Engine::eCommand::eYxStop }};
+
+        const auto it = std::find_if( std::begin( keywords ), std::end( keywords ), [s]( const auto& a ) {
+            return s.find( a.first ) == 0 && ( s.length() == a.first.length() || s[a.first.length()] == ' ' );
+        } );
+        if( it != std::end( keywords )) {
+            rest = Util::Trim( s.substr( it->first.length()));
+            return it->second;
+        }
+        return Engine::eCommand::eUnknown;
+    }
+
+    /**
+     * @brief pipeOut() before the buffer pool, a stringstream and three copies of its text
+     */
+    void StreamPipeOut( SpscQueue<std::string>& queue, std::string& last, const coord_t x, const coord_t y ) {
+        std::stringstream ss;
+        ss << "ERROR my move [" << x << "," << y << "]";
+        last = ss.str();
+        queue.push( ss.str());
+        static_cast<void>( ss.str());
+    }
+
+    /**
+     * @brief Result of one measure
+     */
+    struct Result {
+        double   ns;          /**< nanoseconds per line */
+        uint64_t allocations; /**< heap allocations per 1000 lines */
+        size_t   check;       /**< commands and parameter bytes, both parsers must agree */
+    };
+
+    template<typename Parse>
+    Result Measure( const std::vector<std::string>& lines, const uint32_t count, Parse parse ) {
+        size_t     check       = 0U;
+        const auto allocations = gAllocations.load();
+        const auto start       = Clock::now();
+        for( uint32_t i = 0U; i < count; ++i ) {
+            check += parse( lines[i % lines.size()] );
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start );
+        return Result{ static_cast<double>( elapsed.count()) / count, ( gAllocations.load() - allocations ) * 1000U / count,
+                       check };
+    }
+}
+
+void* operator new( const size_t size ) {
+    ++gAllocations;
+    auto* const p = std::malloc( size == 0U ? 1U : size );
+    if( p == nullptr ) {
+        std::abort();
+    }
+    return p;
+}
+
+void operator delete( void* p ) noexcept {
+    std::free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept {
+    std::free( p );
+}
+
+int main( int argc, char* argv[] ) {
+    const auto count = argc > 1 ? static_cast<uint32_t>( std::stoul( argv[1] )) : 1000000U;
+
+    // a game as the GUI sends it, lines longer than the small string buffer included
+    const std::vector<std::string> lines{ "INFO TIMEOUT_TURN 5000", "INFO TIMEOUT_MATCH 180000", "INFO MAX_MEMORY 83886080",
+                                          "info rule 1", "START 15", "BEGIN", "TURN 7,7", "turn 8,8", "TAKEBACK 8,8",
+                                          "PLAY 9,9", "BOARD", "YXBOARD", "yxshowforbid", "YXRESULT", "YXSTOP",
+                                          "RESTART", "ABOUT", "BOGUS 1,1", "END" };
+
+    const auto vector = Measure( lines, count, []( const std::string& line ) {
+        std::string rest;
+        const auto  cmd = VectorParseCmd( Util::StringToUpper( line ), rest );
+        return static_cast<size_t>( cmd ) + rest.size();
+    } );
+    const auto hash   = Measure( lines, count, []( const std::string& line ) {
+        std::string_view rest;
+        const auto       cmd = Engine::ParseCmd( line, rest );
+        return static_cast<size_t>( cmd ) + rest.size();
+    } );
+
+    std::cout << count << " lines" << ( vector.check == hash.check ? "" : ", the parsers DIFFER" ) << "\n"
+              << "vector  " << vector.ns << " ns/line  " << vector.allocations << " allocations per 1000 lines\n"
+              << "hash    " << hash.ns << " ns/line  " << hash.allocations << " allocations per 1000 lines  "
+              << ( hash.ns > 0.0 ? vector.ns / hash.ns : 0.0 ) << "x\n";
+
+    // an off-board move answers "DEBUG check move [99,7]" and "ERROR my move [99,7]"
+    const std::vector<std::string> moves{ "99,7" };
+    SpscQueue<std::string>         queue;
+    std::string                    last;
+    const auto                     stream = Measure( moves, count, [&queue, &last]( const std::string& ) {
+        StreamPipeOut( queue, last, 99U, 7U );
+        StreamPipeOut( queue, last, 99U, 7U );
+        return queue.pop( 1 ).size() + queue.pop( 1 ).size();
+    } );
+
+    Engine engine( 15 );
+    engine.CmdStart( 15 );
+    std::string line;
+    const auto  respond = [&engine, &line]( const std::string& ) {
+        engine.CmdPutMyMove( 99U, 7U );
+        auto size = engine.ReadFromOutputQueue( line, 1 ) ? line.size() : 0U;
+        size += engine.ReadFromOutputQueue( line, 1 ) ? line.size() : 0U;
+        return size;
+    };
+    Measure( moves, 100U, respond ); // the reader fills the buffer pool
+    const auto pool = Measure( moves, count, respond );
+
+    std::cout << "stream  " << stream.ns << " ns/response pair  " << stream.allocations << " allocations per 1000 pairs\n"
+              << "pool    " << pool.ns << " ns/response pair  " << pool.allocations << " allocations per 1000 pairs  "
+              << ( pool.ns > 0.0 ? stream.ns / pool.ns : 0.0 ) << "x\n";
+    return vector.check == hash.check && hash.allocations == 0U && pool.allocations == 0U ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file queueBench.cpp
+ * @brief Message latency of the engine I/O queues, LockedQueue against SpscQueue
+ *
+ * Usage: queue-bench [messages]
+ * - push and pop in one thread, the bare cost of a message
+ * - is_empty() of an empty queue, the idle poll of the JNI reader
+ * - two threads passing one message back and forth, sleeping in blocking pops
+ **/
+
+#include "../brain/lockedQueue.h"
+#include "../brain/spscQueue.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Nanoseconds per operation
+     */
+    double PerOperation( const Clock::duration elapsed, const uint32_t operations ) {
+        return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count()) /
+               operations;
+    }
+
+    /**
+     * @brief Push and pop in one thread
+     * @tparam Queue LockedQueue or SpscQueue of strings
+     */
+    template<typename Queue>
+    double Uncontended( const uint32_t messages ) {
+        Queue      q;
+        const auto start = Clock::now();
+        for( uint32_t i = 0U; i < messages; ++i ) {
+            q.push( std::string( "MESSAGE DEPTH 12 EV 35 N 123456" ));
+            if( q.pop( 0 ).empty()) {
+                break;
+            }
+        }
+        return PerOperation( Clock::now() - start, messages );
+    }
+
+    /**
+     * @brief is_empty() of an empty queue
+     */
+    template<typename Queue>
+    double EmptyPoll( const uint32_t polls ) {
+        Queue      q;
+        auto       empty = 0U;
+        const auto start = Clock::now();
+        for( uint32_t i = 0U; i < polls; ++i ) {
+            empty += q.is_empty() ? 1U : 0U;
+        }
+        const auto elapsed = Clock::now() - start;
+        return empty == polls ? PerOperation( elapsed, polls ) : 0.0;
+    }
+
+    /**
+     * @brief Ping-pong of two threads, a round trip is two messages
+     */
+    template<typename Queue>
+    double PingPong( const uint32_t messages ) {
+        Queue ping;
+        Queue pong;
+        auto  echo = std::thread( [&]() {
+            for( uint32_t i = 0U; i < messages; ++i ) {
+                pong.push( ping.pop( 0 ));
+            }
+        } );
+
+        const auto start = Clock::now();
+        for( uint32_t i = 0U; i < messages; ++i ) {
+            ping.push( std::string( "MESSAGE DEPTH 12 EV 35 N 123456" ));
+            if( pong.pop( 0 ).empty()) {
+                break;
+            }
+        }
+        const auto elapsed = Clock::now() - start;
+        echo.join();
+        return PerOperation( elapsed, 2U * messages );
+    }
+
+    /**
+     * @brief One result line
+     */
+    void Report( const char* name, const double locked, const double spsc ) {
+        std::cout << name << "  LockedQueue " << locked << " ns  SpscQueue " << spsc << " ns  "
+                  << ( spsc > 0.0 ? locked / spsc : 0.0 ) << "x\n";
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    using Locked = LockedQueue<std::string>;
+    using Spsc   = SpscQueue<std::string>;
+
+    const auto messages = argc > 1 ? static_cast<uint32_t>( std::stoul( argv[1] )) : 100000U;
+    Report( "push+pop  ", Uncontended<Locked>( messages ), Uncontended<Spsc>( messages ));
+    Report( "empty poll", EmptyPoll<Locked>( 10U * messages ), EmptyPoll<Spsc>( 10U * messages ));
+    Report( "ping-pong ", PingPong<Locked>( messages ), PingPong<Spsc>( messages ));
+    return 0;
+}